@@ -0,0 +1 @@
+zconf.tab.c_shipped
\ No newline at end of file
@@ -815,6 +815,90 @@ void base64_init(char *p)
   *(p++) = '/';
 }
 
+// Encode len bytes of in as base64 into out, which needs 4*((len+2)/3) bytes.
+// A partial group at the end gets = padding. Returns bytes written.
+int base64_encode(char *out, char *in, int len)
+{
+  static char table[64];
+  unsigned char *s = (void *)in;
+  char *o = out;
+  unsigned x;
+
+  if (!*table) base64_init(table);
+  for (; len>2; len -= 3, s += 3) {
+    x = (s[0]<<16)|(s[1]<<8)|s[2];
+    *o++ = table[x>>18];
+    *o++ = table[(x>>12)&63];
+    *o++ = table[(x>>6)&63];
+    *o++ = table[x&63];
+  }
+  if (len) {
+    x = (s[0]<<16)|((len>1) ? s[1]<<8 : 0);
+    *o++ = table[x>>18];
+    *o++ = table[(x>>12)&63];
+    *o++ = (len>1) ? table[(x>>6)&63] : '=';
+    *o++ = '=';
+  }
+
+  return o-out;
+}
+
+// Decode base64 from in to out (which can be the same buffer), skipping
+// newlines, and any other non-base64 characters if ignore is set. Stops at
+// = or an invalid character, setting *len to the number of input bytes used.
+// *state carries partial bytes between calls, start it at 0.
+// Returns bytes written.
+int base64_decode(char *out, char *in, int *len, unsigned *state, int ignore)
+{
+  // 0-63 = value, 64 = newline, 65 = '=', 66 = anything else
+  static unsigned char dec[256];
+  unsigned char *s = (void *)in;
+  unsigned x = *state&255, bits = *state>>8, a, b, c, d;
+  char *o = out;
+  int i;
+
+  if (!dec['=']) {
+    char table[64];
+
+    base64_init(table);
+    memset(dec, 66, sizeof(dec));
+    for (i = 0; i<64; i++) dec[(unsigned char)table[i]] = i;
+    dec['\n'] = 64;
+    dec['='] = 65;
+  }
+
+  for (i = 0; i<*len; i++) {
+    // Fast path: decode a whole group at once
+    if (!bits && i+4<=*len) {
+      a = dec[s[i]];
+      b = dec[s[i+1]];
+      c = dec[s[i+2]];
+      d = dec[s[i+3]];
+      if ((a|b|c|d)<64) {
+        x = (a<<18)|(b<<12)|(c<<6)|d;
+        *o++ = x>>16;
+        *o++ = x>>8;
+        *o++ = x;
+        x = 0;
+        i += 3;
+        continue;
+      }
+    }
+    if ((c = dec[s[i]])<64) {
+      x = (x<<6)+c;
+      bits += 6;
+      if (bits>=8) {
+        *o++ = x>>(bits -= 8);
+        x &= (1<<bits)-1;
+      }
+    } else if (c != 64 && !(ignore && c == 66)) break;
+  }
+  *state = (bits<<8)|x;
+  *len = i;
+
+  return o-out;
+}
+
 int yesno(int def)
 {
   char buf;
@@ -1439,3 +1523,16 @@ int is_tar_header(void *pkt)
 
   return i && tar_cksum(pkt) == i;
 }
+
+// Identify compressed data by its magic bytes, returning the name of the
+// command that decompresses it to stdout, or NULL if not recognized.
+char *compression_cat(void *data, int len)
+{
+  char *s = data;
+
+  if (len>1 && SWAP_BE16(*(short *)s)==0x1f8b) return "zcat";
+  if (len>2 && !memcmp(s, "BZh", 3)) return "bzcat";
+  if (len>6 && peek_be(s, 7) == 0xfd377a585a0000) return "xzcat";
+
+  return 0;
+}
@@ -40,6 +40,13 @@ struct num_cache {
   char data[];
 };
 
+// Hash table of num_cache chains, start zeroed.
+struct num_hash {
+  struct num_cache **table;
+  unsigned long count;
+  int bits;
+};
+
 void llist_free_arg(void *node);
 void llist_free_double(void *node);
 void llist_traverse(void *list, void (*using)(void *node));
@@ -51,6 +58,10 @@ void *dlist_terminate(void *list);
 struct num_cache *get_num_cache(struct num_cache *cache, long long num);
 struct num_cache *add_num_cache(struct num_cache **cache, long long num,
   void *data, int len);
+struct num_cache *get_num_hash(struct num_hash *hash, long long num);
+struct num_cache *add_num_hash(struct num_hash *hash, long long num,
+  void *data, int len);
+void free_num_hash(struct num_hash *hash);
 
 // args.c
 #define FLAGS_NODASH (1LL<<63)
@@ -132,6 +143,7 @@ void xputc(char c);
 void xflush(int flush);
 void xexec(char **argv);
 pid_t xpopen_both(char **argv, int *pipes);
+pid_t xpopen_cat(char *cat, int *pipes);
 int xwaitpid(pid_t pid);
 int xpclose_both(pid_t pid, int *pipes);
 pid_t xpopen(char **argv, int *pipe, int isstdout);
@@ -244,6 +256,8 @@ void delete_tempfile(int fdin, int fdout, char **tempname);
 void replace_tempfile(int fdin, int fdout, char **tempname);
 void crc_init(unsigned int *crc_table, int little_endian);
 void base64_init(char *p);
+int base64_encode(char *out, char *in, int len);
+int base64_decode(char *out, char *in, int *len, unsigned *state, int ignore);
 int yesno(int def);
 int qstrcmp(const void *a, const void *b);
 void create_uuid(char *uuid);
@@ -267,6 +281,7 @@ void reset_env(struct passwd *p, int clear);
 void loggit(int priority, char *format, ...);
 unsigned tar_cksum(void *data);
 int is_tar_header(void *pkt);
+char *compression_cat(void *data, int len);
 
 #define HR_SPACE 1 // Space between number and units
 #define HR_B     2 // Use "B" for single byte units
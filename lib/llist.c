@@ -128,3 +128,53 @@ struct num_cache *add_num_cache(struct num_cache **cache, long long num,
 
   return 0;
 }
+
+// Which chain of the table num lives in
+static unsigned long num_hash_slot(struct num_hash *hash, long long num)
+{
+  return (0x9E3779B97F4A7C15ULL*num)>>(64-hash->bits);
+}
+
+// Find num in hash table
+struct num_cache *get_num_hash(struct num_hash *hash, long long num)
+{
+  if (!hash->table) return 0;
+
+  return get_num_cache(hash->table[num_hash_slot(hash, num)], num);
+}
+
+// Uniquely add num+data to hash table, doubling the table when it averages
+// one entry per chain. Returns pointer to existing entry if already there.
+struct num_cache *add_num_hash(struct num_hash *hash, long long num,
+  void *data, int len)
+{
+  struct num_cache **old = hash->table, *nc;
+  unsigned long i;
+
+  if (!old || hash->count >= (1UL<<hash->bits)) {
+    hash->bits = old ? hash->bits+1 : 6;
+    hash->table = xzalloc(sizeof(*old)<<hash->bits);
+    for (i = 0; old && i < (1UL<<(hash->bits-1)); i++) {
+      while ((nc = old[i])) {
+        old[i] = nc->next;
+        nc->next = hash->table[num_hash_slot(hash, nc->num)];
+        hash->table[num_hash_slot(hash, nc->num)] = nc;
+      }
+    }
+    free(old);
+  }
+  nc = add_num_cache(hash->table+num_hash_slot(hash, num), num, data, len);
+  if (!nc) hash->count++;
+
+  return nc;
+}
+
+void free_num_hash(struct num_hash *hash)
+{
+  unsigned long i;
+
+  for (i = 0; hash->table && i < (1UL<<hash->bits); i++)
+    llist_traverse(hash->table[i], free);
+  free(hash->table);
+  memset(hash, 0, sizeof(*hash));
+}
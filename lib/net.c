@@ -1,4 +1,7 @@
 #include "toys.h"
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 
 int xsocket(int domain, int type, int protocol)
 {
@@ -83,41 +86,164 @@ int xpoll(struct pollfd *fds, int nfds, int timeout)
   }
 }
 
+// One direction of a pollinate() relay. Data goes through a kernel pipe
+// with splice() when possible (pipe[0] != -1), else through buf.
+struct relay {
+  int in, out, pipe[2], len, off, done;
+  char *buf;
+};
+
+#define RELAY_BUF 65536
+
+static void relay_nopipe(struct relay *r)
+{
+  close(r->pipe[0]);
+  close(r->pipe[1]);
+  r->pipe[0] = -1;
+}
+
+// Fetch more data from r->in, returning 0 at EOF or error.
+static int relay_read(struct relay *r)
+{
+  int len = -1;
+
+#ifdef __linux__
+  if (r->pipe[0] != -1) {
+    len = syscall(__NR_splice, r->in, 0, r->pipe[1], 0, RELAY_BUF,
+      SPLICE_F_MOVE|SPLICE_F_NONBLOCK);
+    if (len<0 && (errno == EINVAL || errno == ENOSYS)) relay_nopipe(r);
+  }
+#endif
+  if (r->pipe[0] == -1) {
+    len = read(r->in, r->buf, RELAY_BUF);
+    r->off = 0;
+  }
+  if (len<0 && (errno == EAGAIN || errno == EINTR)) return 1;
+  if (len<1) return 0;
+  r->len = len;
+
+  return 1;
+}
+
+// Send what we can of the pending data to r->out without blocking.
+static void relay_write(struct relay *r)
+{
+  int len = -1;
+
+#ifdef __linux__
+  if (r->pipe[0] != -1) {
+    len = syscall(__NR_splice, r->pipe[0], 0, r->out, 0, r->len,
+      SPLICE_F_MOVE|SPLICE_F_NONBLOCK);
+
+    // Output can't splice, so pull what's queued back out of the pipe.
+    if (len<0 && (errno == EINVAL || errno == ENOSYS)) {
+      r->off = 0;
+      r->len = readall(r->pipe[0], r->buf, r->len);
+      relay_nopipe(r);
+    }
+  }
+#endif
+  if (r->pipe[0] == -1) len = write(r->out, r->buf+r->off, r->len);
+  if (len<0) {
+    if (errno == EAGAIN || errno == EINTR) return;
+    perror_exit("write");
+  }
+  r->off += len;
+  r->len -= len;
+}
+
 // Loop forwarding data from in1 to out1 and in2 to out2, handling
 // half-connection shutdown. timeouts return if no data for X ms.
 // Returns 0: both closed, 1 shutdown_timeout, 2 timeout
+//
+// Each direction only reads when its previous data has all been written,
+// and waits for POLLOUT to write, so a stalled reader on one side doesn't
+// block the other direction. Sockets and pipes splice() through a kernel
+// pipe instead of copying through userspace.
 int pollinate(int in1, int in2, int out1, int out2, int timeout, int shutdown_timeout)
 {
+  struct relay r[2] = {{in1, out1, {-1, -1}}, {in2, out2, {-1, -1}}};
   struct pollfd pollfds[2];
-  int i, pollcount = 2;
+  struct stat st;
+  int i, j, k, which[2], flags[2], ret;
+
+  for (i = 0; i<2; i++) {
+    r[i].buf = xmalloc(RELAY_BUF);
 
-  memset(pollfds, 0, 2*sizeof(struct pollfd));
-  pollfds[0].events = pollfds[1].events = POLLIN;
-  pollfds[0].fd = in1;
-  pollfds[1].fd = in2;
+    // Sockets are ours, so it's safe to make writes to them nonblocking.
+    flags[i] = -1;
+    if (!fstat(r[i].out, &st) && S_ISSOCK(st.st_mode)
+      && -1 != (flags[i] = fcntl(r[i].out, F_GETFL)))
+        fcntl(r[i].out, F_SETFL, flags[i]|O_NONBLOCK);
+
+#ifdef __linux__
+    // Splice if either end is a pipe or stream socket, but never datagrams
+    // (which would get merged in the pipe).
+    for (j = k = 0; j<2; j++) {
+      int fd = j ? r[i].out : r[i].in, type = SOCK_STREAM;
+      socklen_t len = sizeof(type);
+
+      if (fstat(fd, &st)) continue;
+      if (S_ISSOCK(st.st_mode))
+        getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &len);
+      else if (!S_ISFIFO(st.st_mode)) continue;
+      if (type != SOCK_STREAM) break;
+      k++;
+    }
+    if (j == 2 && k && pipe(r[i].pipe)) r[i].pipe[0] = -1;
+#endif
+  }
 
   // Poll loop copying data from each fd to the other one.
   for (;;) {
-    if (!xpoll(pollfds, pollcount, timeout)) return pollcount;
+    for (i = j = 0; i<2; i++) {
+      if (r[i].done) continue;
+      pollfds[j].fd = r[i].len ? r[i].out : r[i].in;
+      pollfds[j].events = r[i].len ? POLLOUT : POLLIN;
+      pollfds[j].revents = 0;
+      which[j++] = i;
+    }
+    if (!xpoll(pollfds, j, timeout)) {
+      ret = j;
+      break;
+    }
 
-    for (i=0; i<pollcount; i++) {
-      if (pollfds[i].revents & POLLIN) {
-        int len = read(pollfds[i].fd, libbuf, sizeof(libbuf));
-        if (len<1) pollfds[i].revents = POLLHUP;
-        else xwrite(i ? out2 : out1, libbuf, len);
-      }
-      if (pollfds[i].revents & POLLHUP) {
+    for (i = 0; i<j; i++) {
+      struct relay *rr = r+which[i];
+
+      if (!pollfds[i].revents) continue;
+      if (rr->len) relay_write(rr);
+      else if (!relay_read(rr)) {
         // Close half-connection.  This is needed for things like
         // "echo GET / | netcat landley.net 80"
-        // Note that in1 closing triggers timeout, in2 returns now.
-        if (i) {
-          shutdown(pollfds[0].fd, SHUT_WR);
-          pollcount--;
+        // EOF on in2 waits shutdown_timeout for the reply, in1 returns now.
+        if (which[i]) {
+          shutdown(out2, SHUT_WR);
+          rr->done++;
           timeout = shutdown_timeout;
-        } else return 0;
+        } else {
+          // Pass on what was already read for the other direction first
+          for (k = 0; k<2; k++) while (r[k].len) {
+            struct pollfd pfd = {r[k].out, POLLOUT};
+
+            xpoll(&pfd, 1, -1);
+            relay_write(r+k);
+          }
+          ret = 0;
+          goto done;
+        }
       }
     }
   }
+
+done:
+  for (i = 1; i>=0; i--) {
+    if (flags[i] != -1) fcntl(r[i].out, F_SETFL, flags[i]);
+    if (r[i].pipe[0] != -1) relay_nopipe(r+i);
+    free(r[i].buf);
+  }
+
+  return ret;
 }
 
 // Return converted ipv4/ipv6 numeric address in libbuf
@@ -66,6 +66,12 @@
 #define SEEK_HOLE 4
 #endif
 
+// Introduced in Linux 2.6.17, but glibc only defines them for _GNU_SOURCE
+#ifndef SPLICE_F_MOVE
+#define SPLICE_F_MOVE 1
+#define SPLICE_F_NONBLOCK 2
+#endif
+
 // We don't define GNU_dammit because we're not part of the gnu project, and
 // don't want to get any FSF on us. Unfortunately glibc (gnu libc)
 // won't give us Linux syscall wrappers without claiming to be part of the
@@ -170,6 +176,7 @@ char *strcasestr(const char *haystack, const char *needle);
 // Linux headers not listed by POSIX or LSB
 #include <sys/mount.h>
 #ifdef __linux__
+#include <sys/sendfile.h>
 #include <sys/statfs.h>
 #include <sys/swap.h>
 #include <sys/sysinfo.h>
@@ -309,6 +309,22 @@ pid_t xpopen_both(char **argv, int *pipes)
   return pid;
 }
 
+// Spawn a decompressor ("zcat", "bzcat", or "xzcat") with xpopen_both().
+// A builtin command runs in the forked child without an exec, else try $PATH,
+// else fall back to the matching compressor's -dc.
+pid_t xpopen_cat(char *cat, int *pipes)
+{
+  struct string_list *sl = 0;
+  char *dc = (*cat=='b') ? "bzip2" : (*cat=='x') ? "xz" : "gzip";
+
+  if (!(CFG_TOYBOX && !CFG_TOYBOX_NORECURSE && toys.stacktop && toy_find(cat))
+      && !(sl = find_in_path(getenv("PATH"), cat)))
+    return xpopen_both((char *[]){dc, "-dc", 0}, pipes);
+  llist_traverse(sl, free);
+
+  return xpopen_both((char *[]){cat, 0}, pipes);
+}
+
 // Wait for child process to exit, then return adjusted exit code.
 int xwaitpid(pid_t pid)
 {
@@ -809,11 +825,27 @@ void xpidfile(char *name)
 long long sendfile_len(int in, int out, long long bytes, long long *consumed)
 {
   long long total = 0, len;
+  int kernel = 1;
 
   if (consumed) *consumed = 0;
   if (in<0) return 0;
   while (bytes != total) {
     len = bytes-total;
+#ifdef __linux__
+    // Have the kernel copy without a trip through userspace when it can.
+    // (Input must be mmapable.) On any error retry with read/write below,
+    // which reports the failure the way callers expect.
+    if (kernel) {
+      if (bytes<0 || len>(1<<30)) len = 1<<30;
+      if ((len = sendfile(out, in, 0, len))>0) {
+        if (consumed) *consumed += len;
+        total += len;
+      } else if (!len) break;
+      else kernel = 0;
+
+      continue;
+    }
+#endif
     if (bytes<0 || len>sizeof(libbuf)) len = sizeof(libbuf);
 
     len = read(in, libbuf, len);
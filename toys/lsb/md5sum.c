@@ -13,6 +13,8 @@
  * versions of these functions, but provide a built-in version to reduce
  * required dependencies.
  *
+ * See http://csrc.nist.gov/publications/fips/fips180-4/fips-180-4.pdf for sha2
+ *
  * coreutils supports --status but not -s, busybox supports -s but not --status
 
 USE_MD5SUM(NEWTOY(md5sum, "bc(check)s(status)[!bc]", TOYFLAG_USR|TOYFLAG_BIN))
@@ -52,28 +54,24 @@ config SHA1SUM
 config SHA224SUM
   bool "sha224sum"
   default y
-  depends on TOYBOX_LIBCRYPTO
   help
     See sha1sum
 
 config SHA256SUM
   bool "sha256sum"
   default y
-  depends on TOYBOX_LIBCRYPTO
   help
     See sha1sum
 
 config SHA384SUM
   bool "sha384sum"
   default y
-  depends on TOYBOX_LIBCRYPTO
   help
     See sha1sum
 
 config SHA512SUM
   bool "sha512sum"
   default y
-  depends on TOYBOX_LIBCRYPTO
   help
     See sha1sum
 */
@@ -91,18 +89,39 @@ typedef int SHA512_CTX;
 
 GLOBALS(
   int sawline;
+  char *buf;
+  struct c_ahead *ahead;
+  unsigned ahead_in, ahead_out;
 
   // Crypto variables blanked after summing
-  unsigned state[5];
-  unsigned oldstate[5];
+  union {
+    unsigned i32[8];
+    uint64_t i64[8];
+  } state;
   uint64_t count;
+  unsigned bs;
   union {
-    char c[64];
-    unsigned i[16];
+    char c[128];
+    unsigned i32[32];
+    uint64_t i64[16];
   } buffer;
 )
 
+// Read size: big enough to amortize syscalls, small enough to stay in L2.
+#define HASH_BUF 65536
+
+// -c opens this many files ahead of the one it's hashing and asks the kernel
+// to start reading them, so I/O to different disks overlaps.
+#define CHECK_AHEAD 16
+
+struct c_ahead {
+  char *line, *name;
+  int fd, err;
+};
+
 #define rol(value, bits) (((value) << (bits)) | ((value) >> (32 - (bits))))
+#define ror(value, bits) \
+  (((value) >> (bits)) | ((value) << (8*sizeof(value) - (bits))))
 
 // for(i=0; i<64; i++) md5table[i] = abs(sin(i+1))*(1<<32);  But calculating
 // that involves not just floating point but pulling in -lm (and arguing with
@@ -131,12 +150,14 @@ static const uint8_t md5rot[64] = {
 
 // Mix next 64 bytes of data into md5 hash
 
-static void md5_transform(void)
+static void md5_transform(void *data)
 {
-  unsigned x[4], *b = TT.buffer.i;
+  unsigned x[4], b[16];
   int i;
 
-  memcpy(x, TT.state, sizeof(x));
+  memcpy(b, data, sizeof(b));
+  if (IS_BIG_ENDIAN) for (i=0; i<16; i++) b[i] = SWAP_LE32(b[i]);
+  memcpy(x, TT.state.i32, sizeof(x));
 
   for (i=0; i<64; i++) {
     unsigned int in, temp, swap;
@@ -162,23 +183,24 @@ static void md5_transform(void)
     x[1] += rol(temp, md5rot[i]);
     x[0] = swap;
   }
-  for (i=0; i<4; i++) TT.state[i] += x[i];
+  for (i=0; i<4; i++) TT.state.i32[i] += x[i];
 }
 
 // Mix next 64 bytes of data into sha1 hash.
 
 static const unsigned rconsts[]={0x5A827999,0x6ED9EBA1,0x8F1BBCDC,0xCA62C1D6};
 
-static void sha1_transform(void)
+static void sha1_transform(void *data)
 {
   int i, j, k, count;
-  unsigned *block = TT.buffer.i;
-  unsigned *rot[5], *temp;
+  unsigned block[16], oldstate[5], *rot[5], *temp;
+
+  memcpy(block, data, sizeof(block));
 
   // Copy context->state[] to working vars
   for (i=0; i<5; i++) {
-    TT.oldstate[i] = TT.state[i];
-    rot[i] = TT.state + i;
+    oldstate[i] = TT.state.i32[i];
+    rot[i] = TT.state.i32 + i;
   }
   // 4 rounds of 20 operations each.
   for (i=count=0; i<4; i++) {
@@ -192,9 +214,7 @@ static void sha1_transform(void)
         else work ^= *rot[1];
       }
 
-      if (!i && j<16)
-        work += block[count] = (rol(block[count],24)&0xFF00FF00)
-                             | (rol(block[count],8)&0x00FF00FF);
+      if (!i && j<16) work += block[count] = SWAP_BE32(block[count]);
       else
         work += block[count&15] = rol(block[(count+13)&15]
               ^ block[(count+8)&15] ^ block[(count+2)&15] ^ block[count&15], 1);
@@ -209,33 +229,139 @@ static void sha1_transform(void)
     }
   }
   // Add the previous values of state[]
-  for (i=0; i<5; i++) TT.state[i] += TT.oldstate[i];
+  for (i=0; i<5; i++) TT.state.i32[i] += oldstate[i];
+}
+
+// Fractional parts of the cube roots of the first 80 primes. sha256 uses
+// the top 32 bits of the first 64.
+
+static const uint64_t sha512table[80] = {
+  0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f,
+  0xe9b5dba58189dbbc, 0x3956c25bf348b538, 0x59f111f1b605d019,
+  0x923f82a4af194f9b, 0xab1c5ed5da6d8118, 0xd807aa98a3030242,
+  0x12835b0145706fbe, 0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
+  0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235,
+  0xc19bf174cf692694, 0xe49b69c19ef14ad2, 0xefbe4786384f25e3,
+  0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65, 0x2de92c6f592b0275,
+  0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5,
+  0x983e5152ee66dfab, 0xa831c66d2db43210, 0xb00327c898fb213f,
+  0xbf597fc7beef0ee4, 0xc6e00bf33da88fc2, 0xd5a79147930aa725,
+  0x06ca6351e003826f, 0x142929670a0e6e70, 0x27b70a8546d22ffc,
+  0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed, 0x53380d139d95b3df,
+  0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6,
+  0x92722c851482353b, 0xa2bfe8a14cf10364, 0xa81a664bbc423001,
+  0xc24b8b70d0f89791, 0xc76c51a30654be30, 0xd192e819d6ef5218,
+  0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8,
+  0x19a4c116b8d2d0c8, 0x1e376c085141ab53, 0x2748774cdf8eeb99,
+  0x34b0bcb5e19b48a8, 0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb,
+  0x5b9cca4f7763e373, 0x682e6ff3d6b2b8a3, 0x748f82ee5defb2fc,
+  0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
+  0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915,
+  0xc67178f2e372532b, 0xca273eceea26619c, 0xd186b8c721c0c207,
+  0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178, 0x06f067aa72176fba,
+  0x0a637dc5a2c898a6, 0x113f9804bef90dae, 0x1b710b35131c471b,
+  0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc,
+  0x431d67c49c100d4c, 0x4cc5d4becb3e42b6, 0x597f299cfc657e2a,
+  0x5fcb6fab3ad6faec, 0x6c44198c4a475817
+};
+
+// Fractional parts of the square roots of the first 16 primes: sha512 then
+// sha384 initial state. sha256 uses the top 32 bits of the sha512 values,
+// sha224 the bottom 32 bits of the sha384 ones.
+
+static const uint64_t sha512init[16] = {
+  0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b,
+  0xa54ff53a5f1d36f1, 0x510e527fade682d1, 0x9b05688c2b3e6c1f,
+  0x1f83d9abfb41bd6b, 0x5be0cd19137e2179, 0xcbbb9d5dc1059ed8,
+  0x629a292a367cd507, 0x9159015a3070dd17, 0x152fecd8f70e5939,
+  0x67332667ffc00b31, 0x8eb44a8768581511, 0xdb0c2e0d64f98fa7,
+  0x47b5481dbefa4fa4
+};
+
+// Mix next 64 bytes of data into sha224/sha256 hash.
+
+static void sha256_transform(void *data)
+{
+  unsigned w[64], a, b, c, d, e, f, g, h, t1, t2;
+  int i;
+
+  memcpy(w, data, 64);
+  for (i=0; i<16; i++) w[i] = SWAP_BE32(w[i]);
+  for (; i<64; i++)
+    w[i] = w[i-16] + w[i-7]
+      + (ror(w[i-15], 7) ^ ror(w[i-15], 18) ^ (w[i-15] >> 3))
+      + (ror(w[i-2], 17) ^ ror(w[i-2], 19) ^ (w[i-2] >> 10));
+
+  a = TT.state.i32[0]; b = TT.state.i32[1];
+  c = TT.state.i32[2]; d = TT.state.i32[3];
+  e = TT.state.i32[4]; f = TT.state.i32[5];
+  g = TT.state.i32[6]; h = TT.state.i32[7];
+  for (i=0; i<64; i++) {
+    t1 = h + (ror(e, 6) ^ ror(e, 11) ^ ror(e, 25)) + ((e&f) ^ (~e&g))
+      + (unsigned)(sha512table[i]>>32) + w[i];
+    t2 = (ror(a, 2) ^ ror(a, 13) ^ ror(a, 22)) + ((a&b) ^ (a&c) ^ (b&c));
+    h = g; g = f; f = e; e = d+t1;
+    d = c; c = b; b = a; a = t1+t2;
+  }
+  TT.state.i32[0] += a; TT.state.i32[1] += b;
+  TT.state.i32[2] += c; TT.state.i32[3] += d;
+  TT.state.i32[4] += e; TT.state.i32[5] += f;
+  TT.state.i32[6] += g; TT.state.i32[7] += h;
+}
+
+// Mix next 128 bytes of data into sha384/sha512 hash.
+
+static void sha512_transform(void *data)
+{
+  uint64_t w[80], a, b, c, d, e, f, g, h, t1, t2;
+  int i;
+
+  memcpy(w, data, 128);
+  for (i=0; i<16; i++) w[i] = SWAP_BE64(w[i]);
+  for (; i<80; i++)
+    w[i] = w[i-16] + w[i-7]
+      + (ror(w[i-15], 1) ^ ror(w[i-15], 8) ^ (w[i-15] >> 7))
+      + (ror(w[i-2], 19) ^ ror(w[i-2], 61) ^ (w[i-2] >> 6));
+
+  a = TT.state.i64[0]; b = TT.state.i64[1];
+  c = TT.state.i64[2]; d = TT.state.i64[3];
+  e = TT.state.i64[4]; f = TT.state.i64[5];
+  g = TT.state.i64[6]; h = TT.state.i64[7];
+  for (i=0; i<80; i++) {
+    t1 = h + (ror(e, 14) ^ ror(e, 18) ^ ror(e, 41)) + ((e&f) ^ (~e&g))
+      + sha512table[i] + w[i];
+    t2 = (ror(a, 28) ^ ror(a, 34) ^ ror(a, 39)) + ((a&b) ^ (a&c) ^ (b&c));
+    h = g; g = f; f = e; e = d+t1;
+    d = c; c = b; b = a; a = t1+t2;
+  }
+  TT.state.i64[0] += a; TT.state.i64[1] += b;
+  TT.state.i64[2] += c; TT.state.i64[3] += d;
+  TT.state.i64[4] += e; TT.state.i64[5] += f;
+  TT.state.i64[6] += g; TT.state.i64[7] += h;
 }
 
-// Fill the 64-byte working buffer and call transform() when full.
+// Feed data to transform() one frame (TT.bs bytes) at a time. Whole frames
+// are hashed straight out of the caller's buffer, only a leftover partial
+// frame gets copied into TT.buffer to wait for more data.
 
-static void hash_update(char *data, unsigned int len, void (*transform)(void))
+static void hash_update(char *data, unsigned len, void (*transform)(void *))
 {
-  unsigned int i, j;
+  unsigned i, j = TT.count & (TT.bs-1);
 
-  j = TT.count & 63;
   TT.count += len;
 
-  for (;;) {
-    // Grab next chunk of data, return if it's not enough to process a frame
-    i = 64 - j;
+  // Top up partial frame from last time
+  if (j) {
+    i = TT.bs - j;
     if (i>len) i = len;
     memcpy(TT.buffer.c+j, data, i);
-    if (j+i != 64) break;
-
-    // Process a frame
-    if (IS_BIG_ENDIAN)
-      for (j=0; j<16; j++) TT.buffer.i[j] = SWAP_LE32(TT.buffer.i[j]);
-    transform();
-    j=0;
+    if (j+i != TT.bs) return;
+    transform(TT.buffer.c);
     data += i;
     len -= i;
   }
+  for (; len >= TT.bs; len -= TT.bs, data += TT.bs) transform(data);
+  memcpy(TT.buffer.c, data, len);
 }
 
 // Initialize array tersely
@@ -274,9 +400,9 @@ static void do_lib_hash(int fd, char *name)
 
   hash->init(&ctx);
   for (;;) {
-      i = read(fd, toybuf, sizeof(toybuf));
+      i = read(fd, TT.buf, HASH_BUF);
       if (i<1) break;
-      hash->update(&ctx, toybuf, i);
+      hash->update(&ctx, TT.buf, i);
   }
   hash->final(toybuf+128, &ctx);
 
@@ -288,31 +414,47 @@ static void do_lib_hash(int fd, char *name)
 
 static void do_builtin_hash(int fd, char *name)
 {
-  uint64_t count;
-  int i, sha1=toys.which->name[0]=='s';
+  uint64_t count[2];
+  // md5sum=0, sha1sum=1, sha224sum=224...
+  int i, len, alg = atoi(toys.which->name+3);
   char buf;
-  void (*transform)(void);
-
-  /* SHA1 initialization constants  (md5sum uses first 4) */
-  TT.state[0] = 0x67452301;
-  TT.state[1] = 0xEFCDAB89;
-  TT.state[2] = 0x98BADCFE;
-  TT.state[3] = 0x10325476;
-  TT.state[4] = 0xC3D2E1F0;
+  void (*transform)(void *);
+
   TT.count = 0;
+  TT.bs = 64;
+  if (alg<2) {
+    /* SHA1 initialization constants  (md5sum uses first 4) */
+    TT.state.i32[0] = 0x67452301;
+    TT.state.i32[1] = 0xEFCDAB89;
+    TT.state.i32[2] = 0x98BADCFE;
+    TT.state.i32[3] = 0x10325476;
+    TT.state.i32[4] = 0xC3D2E1F0;
+    transform = alg ? sha1_transform : md5_transform;
+    len = alg ? 20 : 16;
+  } else {
+    for (i=0; i<8; i++) {
+      if (alg==224) TT.state.i32[i] = sha512init[i+8];
+      else if (alg==256) TT.state.i32[i] = sha512init[i]>>32;
+      else TT.state.i64[i] = sha512init[i+8*(alg==384)];
+    }
+    if (alg>256) TT.bs = 128;
+    transform = (alg>256) ? sha512_transform : sha256_transform;
+    len = alg/8;
+  }
 
-  transform = sha1 ? sha1_transform : md5_transform;
   for (;;) {
-    i = read(fd, toybuf, sizeof(toybuf));
+    i = read(fd, TT.buf, HASH_BUF);
     if (i<1) break;
-    hash_update(toybuf, i, transform);
+    hash_update(TT.buf, i, transform);
   }
 
-  count = TT.count << 3;
+  count[0] = 0;
+  count[1] = TT.count << 3;
 
   // End the message by appending a "1" bit to the data, ending with the
   // message size (in bits, big endian), and adding enough zero bits in
-  // between to pad to the end of the next 64-byte frame.
+  // between to pad to the end of the next frame. (sha384/512 have a 128 bit
+  // size field, the top half of which is always zero for us.)
   //
   // Since our input up to now has been in whole bytes, we can deal with
   // bytes here too.
@@ -321,17 +463,19 @@ static void do_builtin_hash(int fd, char *name)
   do {
     hash_update(&buf, 1, transform);
     buf = 0;
-  } while ((TT.count & 63) != 56);
-  count = sha1 ? SWAP_BE64(count) : SWAP_LE64(count);
-  hash_update((void *)&count, 8, transform);
+  } while ((TT.count & (TT.bs-1)) != TT.bs-TT.bs/8);
+  count[1] = alg ? SWAP_BE64(count[1]) : SWAP_LE64(count[1]);
+  hash_update((char *)(count+2)-TT.bs/8, TT.bs/8, transform);
 
-  if (sha1)
-    for (i = 0; i < 20; i++)
-      sprintf(toybuf+2*i, "%02x", 255&(TT.state[i>>2] >> ((3-(i & 3)) * 8)));
-  else for (i=0; i<4; i++) sprintf(toybuf+8*i, "%08x", bswap_32(TT.state[i]));
+  // md5 is little endian, the rest big endian 32 or 64 bit words
+  for (i = 0; i<len; i++)
+    sprintf(toybuf+2*i, "%02x", 255&(int)(!alg ? TT.state.i32[i>>2] >> (8*(i&3))
+      : (TT.bs==128) ? TT.state.i64[i>>3] >> ((7-(i&7))*8)
+      : TT.state.i32[i>>2] >> ((3-(i&3))*8)));
 
   // Wipe variables. Cryptographer paranoia.
-  memset(TT.state, 0, sizeof(TT)-((long)TT.state-(long)&TT));
+  memset(TT.buf, 0, minof(TT.count, HASH_BUF));
+  memset(&TT.state, 0, sizeof(TT)-((long)&TT.state-(long)&TT));
   i = strlen(toybuf)+1;
   memset(toybuf+i, 0, sizeof(toybuf)-i);
 }
@@ -346,9 +490,34 @@ static void do_hash(int fd, char *name)
     printf((toys.optflags & FLAG_b) ? "%s\n" : "%s  %s\n", toybuf, name);
 }
 
-static int do_c_line(char *line)
+// Hash and report the oldest queued -c entry.
+static void check_one(void)
+{
+  struct c_ahead *ca = TT.ahead+(TT.ahead_out++%CHECK_AHEAD);
+  int fail = 0;
+
+  if (ca->fd==-1) {
+    errno = ca->err;
+    perror_msg_raw(ca->name);
+    *toybuf = 0;
+  } else do_hash(ca->fd, 0);
+  if (strcasecmp(ca->line, toybuf)) toys.exitval = fail = 1;
+  if (!FLAG(s)) printf("%s: %s\n", ca->name, fail ? "FAILED" : "OK");
+  if (ca->fd>0) close(ca->fd);
+  free(ca->line);
+}
+
+static void check_all(void)
+{
+  while (TT.ahead_out != TT.ahead_in) check_one();
+}
+
+// Open the file a line refers to and queue it, checking the oldest entry
+// first if the queue is full. Takes ownership of line.
+static void do_c_line(char *line)
 {
-  int space = 0, fail = 0;
+  struct c_ahead *ca;
+  int space = 0;
   char *name;
 
   for (name = line; *name; name++) {
@@ -358,21 +527,22 @@ static int do_c_line(char *line)
     } else if (space) break;
   }
 
-  if (!space || !*line || !*name) error_msg("bad line %s", line);
-  else {
-    int fd = !strcmp(name, "-") ? 0 : open(name, O_RDONLY);
-
-    TT.sawline = 1;
-    if (fd==-1) {
-      perror_msg_raw(name);
-      *toybuf = 0;
-    } else do_hash(fd, 0);
-    if (strcasecmp(line, toybuf)) toys.exitval = fail = 1;
-    if (!FLAG(s)) printf("%s: %s\n", name, fail ? "FAILED" : "OK");
-    if (fd>0) close(fd);
+  if (!space || !*line || !*name) {
+    check_all();
+    error_msg("bad line %s", line);
+    free(line);
+
+    return;
   }
 
-  return 0;
+  TT.sawline = 1;
+  if (TT.ahead_in-TT.ahead_out == CHECK_AHEAD) check_one();
+  ca = TT.ahead+(TT.ahead_in++%CHECK_AHEAD);
+  ca->line = line;
+  ca->name = name;
+  ca->fd = !strcmp(name, "-") ? 0 : open(name, O_RDONLY);
+  ca->err = errno;
+  if (ca->fd>0) posix_fadvise(ca->fd, 0, 0, POSIX_FADV_WILLNEED);
 }
 
 // Used instead of loopfiles_line to report error on files containing no hashes.
@@ -391,11 +561,14 @@ static void do_c_file(char *name)
     char *line = 0;
     ssize_t len;
 
-    if ((len = getline(&line, (void *)&len, fp))<1) break;
+    if ((len = getline(&line, (void *)&len, fp))<1) {
+      free(line);
+      break;
+    }
     if (line[len-1]=='\n') line[len-1] = 0;
     do_c_line(line);
-    free(line);
   }
+  check_all();
   if (fp!=stdin) fclose(fp);
 
   if (!TT.sawline) error_msg("%s: no lines", name);
@@ -405,8 +578,12 @@ void md5sum_main(void)
 {
   char **arg;
 
-  if (FLAG(c)) for (arg = toys.optargs; *arg; arg++) do_c_file(*arg);
-  else {
+  TT.buf = xmalloc(HASH_BUF);
+
+  if (FLAG(c)) {
+    TT.ahead = xmalloc(CHECK_AHEAD*sizeof(struct c_ahead));
+    for (arg = toys.optargs; *arg; arg++) do_c_file(*arg);
+  } else {
     if (FLAG(s)) error_exit("-s only with -c");
     loopfiles(toys.optargs, do_hash);
   }
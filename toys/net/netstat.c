@@ -30,9 +30,15 @@ config NETSTAT
 #define FOR_netstat
 #include "toys.h"
 #include <net/route.h>
+#include <linux/netlink.h>
+#include <linux/sock_diag.h>
+#include <linux/inet_diag.h>
+
+#define DIAG_BUF 32768
 
 GLOBALS(
-  struct num_cache *inodes;
+  struct num_hash inodes;
+  char *diagbuf;
   int wpad;
 );
 
@@ -100,17 +106,108 @@ static void addr2str(int af, void *addr, unsigned port, char *buf, int len,
   else sprintf(buf+pos, ":%u", port);
 }
 
-// Display info for tcp/udp/raw
-static void show_ip(char *fname)
+// Display one tcp/udp/raw socket, if it's one of the ones we show
+static void show_ip_socket(char *label, int af, void *laddr, unsigned lport,
+  void *raddr, unsigned rport, unsigned state, unsigned txq, unsigned rxq,
+  unsigned uid, unsigned long inode)
 {
-  char *ss_state = "UNKNOWN", buf[12], *s, *label = strrchr(fname, '/')+1;
+  char *ss_state = "UNKNOWN", buf[12], *s, lip[256], rip[256];
   char *state_label[] = {"", "ESTABLISHED", "SYN_SENT", "SYN_RECV", "FIN_WAIT1",
                          "FIN_WAIT2", "TIME_WAIT", "CLOSE", "CLOSE_WAIT",
                          "LAST_ACK", "LISTEN", "CLOSING", "UNKNOWN"};
   struct passwd *pw;
-  FILE *fp = fopen(fname, "r");
 
-  if (!fp) {
+  // Should we display this? (all, or listening with -l, else connected)
+  if (!FLAG(a) && !FLAG(l) == (!rport && (state & 0xA))) return;
+
+  addr2str(af, laddr, lport, lip, TT.wpad, label);
+  addr2str(af, raddr, rport, rip, TT.wpad, label);
+
+  // Display data
+  s = label;
+  if (strstart(&s, "tcp")) {
+    int sz = ARRAY_LEN(state_label);
+    if (!state || state >= sz) state = sz-1;
+    ss_state = state_label[state];
+  } else if (strstart(&s, "udp")) {
+    if (state == 1) ss_state = state_label[state];
+    else if (state == 7) ss_state = "";
+  } else if (strstart(&s, "raw")) sprintf(ss_state = buf, "%u", state);
+
+  if (!(toys.optflags & FLAG_n) && (pw = bufgetpwuid(uid)))
+    snprintf(toybuf, sizeof(toybuf), "%s", pw->pw_name);
+  else snprintf(toybuf, sizeof(toybuf), "%d", uid);
+
+  printf("%-6s%6d%7d ", label, rxq, txq);
+  printf("%*.*s %*.*s ", -TT.wpad, TT.wpad, lip, -TT.wpad, TT.wpad, rip);
+  printf("%-11s", ss_state);
+  if ((toys.optflags & FLAG_e)) printf(" %-10s %-11ld", toybuf, inode);
+  if ((toys.optflags & FLAG_p)) {
+    struct num_cache *nc = get_num_hash(&TT.inodes, inode);
+
+    printf(" %s", nc ? nc->data : "-");
+  }
+  xputc('\n');
+}
+
+// Ask the kernel for tcp or udp sockets via NETLINK_SOCK_DIAG, which skips
+// the states we won't show and saves formatting and parsing /proc/net text.
+// Returns 0 if that didn't work before showing anything, to fall back to text.
+static int diag_ip(char *label, int af, int proto)
+{
+  struct {
+    struct nlmsghdr nlh;
+    struct inet_diag_req_v2 req;
+  } msg;
+  struct nlmsghdr *nlh;
+  struct inet_diag_msg *idm;
+  unsigned listen = (1<<TCP_LISTEN)|(1<<TCP_CLOSE), txq;
+  int fd, len, shown = 0;
+
+  if (-1 == (fd = socket(AF_NETLINK, SOCK_DGRAM, NETLINK_SOCK_DIAG))) return 0;
+  if (!TT.diagbuf) TT.diagbuf = xmalloc(DIAG_BUF);
+
+  memset(&msg, 0, sizeof(msg));
+  msg.nlh.nlmsg_len = sizeof(msg);
+  msg.nlh.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+  msg.nlh.nlmsg_flags = NLM_F_REQUEST|NLM_F_DUMP;
+  msg.req.sdiag_family = af;
+  msg.req.sdiag_protocol = proto;
+  msg.req.idiag_states = FLAG(a) ? ~0 : FLAG(l) ? listen : ~listen;
+  if (send(fd, &msg, sizeof(msg), 0) != sizeof(msg)) goto done;
+
+  while ((len = recv(fd, TT.diagbuf, DIAG_BUF, 0)) > 0) {
+    for (nlh = (void *)TT.diagbuf; NLMSG_OK(nlh, len);
+         nlh = NLMSG_NEXT(nlh, len))
+    {
+      if (nlh->nlmsg_type == NLMSG_DONE) shown++;
+      if (nlh->nlmsg_type == NLMSG_DONE || nlh->nlmsg_type == NLMSG_ERROR)
+        goto done;
+      idm = NLMSG_DATA(nlh);
+
+      // /proc/net/tcp shows no send queue for listening sockets
+      txq = idm->idiag_state == TCP_LISTEN ? 0 : idm->idiag_wqueue;
+      show_ip_socket(label, af, idm->id.idiag_src, ntohs(idm->id.idiag_sport),
+        idm->id.idiag_dst, ntohs(idm->id.idiag_dport), idm->idiag_state, txq,
+        idm->idiag_rqueue, idm->idiag_uid, idm->idiag_inode);
+      shown++;
+    }
+  }
+
+done:
+  close(fd);
+
+  return shown;
+}
+
+// Display info for tcp/udp/raw
+static void show_ip(char *fname, int af, int proto)
+{
+  char *label = strrchr(fname, '/')+1;
+  FILE *fp;
+
+  if (proto && diag_ip(label, af, proto)) return;
+  if (!(fp = fopen(fname, "r"))) {
      perror_msg("'%s'", fname);
      return;
   }
@@ -118,7 +215,6 @@ static void show_ip(char *fname)
   if(!fgets(toybuf, sizeof(toybuf), fp)) return; //skip header.
 
   while (fgets(toybuf, sizeof(toybuf), fp)) {
-    char lip[256], rip[256];
     union {
       struct {unsigned u; unsigned char b[4];} i4;
       struct {struct {unsigned a, b, c, d;} u; unsigned char b[16];} i6;
@@ -144,39 +240,8 @@ static void show_ip(char *fname)
       nitems = AF_INET;
     } else nitems = AF_INET6;
 
-    // Should we display this? (listening or all or TCP/UDP/RAW)
-    if (!((toys.optflags & FLAG_l) && (!rport && (state & 0xA)))
-      && !(toys.optflags & FLAG_a) && !(rport & (0x10 | 0x20 | 0x40)))
-        continue;
-
-    addr2str(nitems, &laddr, lport, lip, TT.wpad, label);
-    addr2str(nitems, &raddr, rport, rip, TT.wpad, label);
-
-    // Display data
-    s = label;
-    if (strstart(&s, "tcp")) {
-      int sz = ARRAY_LEN(state_label);
-      if (!state || state >= sz) state = sz-1;
-      ss_state = state_label[state];
-    } else if (strstart(&s, "udp")) {
-      if (state == 1) ss_state = state_label[state];
-      else if (state == 7) ss_state = "";
-    } else if (strstart(&s, "raw")) sprintf(ss_state = buf, "%u", state);
-
-    if (!(toys.optflags & FLAG_n) && (pw = bufgetpwuid(uid)))
-      snprintf(toybuf, sizeof(toybuf), "%s", pw->pw_name);
-    else snprintf(toybuf, sizeof(toybuf), "%d", uid);
-
-    printf("%-6s%6d%7d ", label, rxq, txq);
-    printf("%*.*s %*.*s ", -TT.wpad, TT.wpad, lip, -TT.wpad, TT.wpad, rip);
-    printf("%-11s", ss_state);
-    if ((toys.optflags & FLAG_e)) printf(" %-10s %-11ld", toybuf, inode);
-    if ((toys.optflags & FLAG_p)) {
-      struct num_cache *nc = get_num_cache(TT.inodes, inode);
-
-      printf(" %s", nc ? nc->data : "-");
-    }
-    xputc('\n');
+    show_ip_socket(label, nitems, &laddr, lport, &raddr, rport, state, txq,
+      rxq, uid, inode);
   }
   fclose(fp);
 }
@@ -214,7 +279,7 @@ static void show_unix_sockets(void)
     printf("unix  %-6ld %-11s %-10s %-13s %8lu ",
       refcount, toybuf, types[type], states[state], inode);
     if (toys.optflags & FLAG_p) {
-      struct num_cache *nc = get_num_cache(TT.inodes, inode);
+      struct num_cache *nc = get_num_hash(&TT.inodes, inode);
 
       printf("%-19.19s", nc ? nc->data : "-");
     }
@@ -258,7 +323,7 @@ static int scan_pids(struct dirtree *node)
       long long ll = atoll(s);
 
       sprintf(s, "%d/%s", pid, getbasename(toybuf));
-      add_num_cache(&TT.inodes, ll, s, strlen(s)+1);
+      add_num_hash(&TT.inodes, ll, s, strlen(s)+1);
     }
   }
   closedir(dp);
@@ -356,16 +421,17 @@ void netstat_main(void)
     xputc('\n');
 
     if (toys.optflags & FLAG_t) {
-      show_ip("/proc/net/tcp");
-      show_ip("/proc/net/tcp6");
+      show_ip("/proc/net/tcp", AF_INET, IPPROTO_TCP);
+      show_ip("/proc/net/tcp6", AF_INET6, IPPROTO_TCP);
     }
     if (toys.optflags & FLAG_u) {
-      show_ip("/proc/net/udp");
-      show_ip("/proc/net/udp6");
+      show_ip("/proc/net/udp", AF_INET, IPPROTO_UDP);
+      show_ip("/proc/net/udp6", AF_INET6, IPPROTO_UDP);
     }
     if (toys.optflags & FLAG_w) {
-      show_ip("/proc/net/raw");
-      show_ip("/proc/net/raw6");
+      // raw_diag only matches one protocol at a time, so read the text
+      show_ip("/proc/net/raw", AF_INET, 0);
+      show_ip("/proc/net/raw6", AF_INET6, 0);
     }
   }
 
@@ -377,7 +443,9 @@ void netstat_main(void)
     show_unix_sockets();
   }
 
-  if ((toys.optflags & FLAG_p) && CFG_TOYBOX_FREE)
-    llist_traverse(TT.inodes, free);
+  if (CFG_TOYBOX_FREE) {
+    if (toys.optflags & FLAG_p) free_num_hash(&TT.inodes);
+    free(TT.diagbuf);
+  }
   toys.exitval = 0;
 }
@@ -52,18 +52,76 @@ GLOBALS(
 
   struct sockaddr *sa;
   int sock;
-  unsigned long sent, recv, fugit, min, max;
+  unsigned long sent, recv, dup, timed, min, max, *hist;
+  unsigned long long fugit;
+  unsigned char *pending;
 )
 
+// Most packets sent or received per trip around the main loop
+#define PING_BURST 64
+
+// Round trip times in microseconds go in a histogram of 32 buckets per power
+// of 2, which is good to 3% for percentiles without storing every sample.
+#define PING_HIST (28*32)
+
+static int hist_slot(unsigned us)
+{
+  int b;
+
+  if (us<32) return us;
+  for (b = 31; !(us>>b); b--);
+
+  return ((b-4)<<5)|((us>>(b-5))&31);
+}
+
+static unsigned long hist_usec(int slot)
+{
+  return slot<32 ? slot : (32|(slot&31))<<((slot>>5)-1);
+}
+
+// Microsecond clock, truncated to 32 bits. Fine for differences under an hour.
+static unsigned usec(struct timeval *tv)
+{
+  struct timeval now;
+
+  if (!tv) gettimeofday(tv = &now, 0);
+
+  return tv->tv_sec*1000000U+tv->tv_usec;
+}
+
+static void print_ms(char *sep, unsigned long us)
+{
+  printf("%s%lu.%03lu", sep, us/1000, us%1000);
+}
+
 // Print a summary. Called as a single handler or at exit.
 static void summary(int sig)
 {
+  int i, j, slot;
+  unsigned long n, pct[] = {500, 990, 999};
+
   if (!(toys.optflags&FLAG_q) && TT.sent && TT.sa) {
     printf("\n--- %s ping statistics ---\n", ntop(TT.sa));
-    printf("%lu packets transmitted, %lu received, %ld%% packet loss\n",
-      TT.sent, TT.recv, ((TT.sent-TT.recv)*100)/(TT.sent?TT.sent:1));
-    printf("round-trip min/avg/max = %lu/%lu/%lu ms\n",
-      TT.min, TT.max, TT.fugit/(TT.recv?TT.recv:1));
+    printf("%lu packets transmitted, %lu received, ", TT.sent, TT.recv);
+    if (TT.dup) printf("+%lu duplicates, ", TT.dup);
+    printf("%ld%% packet loss\n",
+      ((TT.sent-TT.recv)*100)/(TT.sent?TT.sent:1));
+    // Replies too short to carry a timestamp (-s 0..3) have no round trip
+    if (TT.timed) {
+      print_ms("round-trip min/avg/max = ", TT.min);
+      print_ms("/", TT.fugit/TT.timed);
+      print_ms("/", TT.max);
+      printf(" ms\nround-trip p50/p99/p999 =");
+
+      // Lowest bucket holding the nth sample, clamped to what we saw
+      for (i = slot = n = 0; i<ARRAY_LEN(pct); i++) {
+        for (j = (TT.timed*pct[i]+999)/1000; n<j && slot<PING_HIST;)
+          n += TT.hist[slot++];
+        print_ms(i ? "/" : " ", slot ? (hist_usec(slot-1)<TT.min ? TT.min
+          : hist_usec(slot-1)>TT.max ? TT.max : hist_usec(slot-1)) : TT.min);
+      }
+      printf(" ms\n");
+    }
   }
   TT.sa = 0;
 }
@@ -92,8 +150,13 @@ void ping_main(void)
   union socksaddr srcaddr, srcaddr2;
   struct sockaddr *sa = (void *)&srcaddr;
   int family = 0, len;
+  struct pollfd pfd;
+  struct msghdr msg;
+  struct iovec iov;
+  char ctl[CMSG_SPACE(sizeof(struct timeval))];
   long long tnext, tW, tnow, tw;
-  unsigned short seq = 0, pkttime;
+  unsigned short seq = 0;
+  unsigned pkttime = 0;
 
   // Set nonstatic default values
   if (!(toys.optflags&FLAG_i)) TT.i = (toys.optflags&FLAG_f) ? 200 : 1000;
@@ -185,12 +248,19 @@ void ping_main(void)
   tW = tw = 0;
   tnext = millitime();
   if (TT.w) tw = TT.w*1000+tnext;
+  TT.hist = xzalloc(PING_HIST*sizeof(long));
+  TT.pending = xzalloc(65536/8);
+
+  // Have the kernel stamp replies as they arrive, so time waiting to be read
+  // doesn't count against the round trip
+  len = 1;
+  setsockopt(TT.sock, SOL_SOCKET, SO_TIMESTAMP, &len, sizeof(len));
 
   sigatexit(summary);
 
   // Send/receive packets
   for (;;) {
-    int waitms = INT_MAX;
+    int waitms = INT_MAX, burst;
 
     // Exit due to timeout? (TODO: timeout is after last packet, waiting if
     // any packets ever dropped. Not timeout since packet was dropped.)
@@ -204,19 +274,21 @@ void ping_main(void)
       else if (waitms>tw-tnow) waitms = tw-tnow;
     }
 
-    // Time to send the next packet?
-    if (!tW && tnext-tnow <= 0) {
+    // Send every packet that's come due, so short intervals keep up their
+    // rate even when we wake up late.
+    for (burst = 0; !tW && tnext-tnow <= 0 && burst<PING_BURST; burst++) {
       tnext += TT.i;
 
       memset(ih, 0, sizeof(*ih));
       ih->type = (ai->ai_family == AF_INET) ? 8 : 128;
       ih->un.echo.id = getpid();
       ih->un.echo.sequence = ++seq;
-      if (TT.s >= 4) *(unsigned *)(ih+1) = tnow;
+      if (TT.s >= 4) *(unsigned *)(ih+1) = usec(0);
 
       ih->checksum = 0;
       ih->checksum = pingchksum((void *)toybuf, TT.s+sizeof(*ih));
       xsendto(TT.sock, toybuf, TT.s+sizeof(*ih), TT.sa);
+      TT.pending[seq/8] |= 1<<(seq&7);
       TT.sent++;
       if ((toys.optflags&(FLAG_f|FLAG_q)) == FLAG_f) xputc('.');
 
@@ -233,26 +305,71 @@ void ping_main(void)
     // wait for next packet or timeout
 
     if (waitms<0) waitms = 0;
-    if (!(len = xrecvwait(TT.sock, toybuf, sizeof(toybuf), &srcaddr2, waitms)))
-      continue;
+    pfd.fd = TT.sock;
+    pfd.events = POLLIN;
+    if (!xpoll(&pfd, 1, waitms)) continue;
+
+    // Read everything that's arrived
+    for (burst = 0; burst<PING_BURST; burst++) {
+      struct timeval *tv = 0;
+      struct cmsghdr *cm;
+      unsigned pktseq, bit, dup;
+
+      iov.iov_base = toybuf;
+      iov.iov_len = sizeof(toybuf);
+      memset(&msg, 0, sizeof(msg));
+      msg.msg_name = &srcaddr2;
+      msg.msg_namelen = sizeof(srcaddr2);
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+      msg.msg_control = ctl;
+      msg.msg_controllen = sizeof(ctl);
+      if (0>(len = recvmsg(TT.sock, &msg, MSG_DONTWAIT))) {
+        if (errno==EAGAIN || errno==EINTR) break;
+        perror_exit("recvmsg");
+      }
+      for (cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm))
+        if (cm->cmsg_level==SOL_SOCKET && cm->cmsg_type==SO_TIMESTAMP)
+          tv = (void *)CMSG_DATA(cm);
+
+      // A reply to a sequence number we're not waiting on is a duplicate
+      pktseq = ih->un.echo.sequence;
+      bit = 1<<(pktseq&7);
+      if ((dup = !(TT.pending[pktseq/8]&bit))) TT.dup++;
+      else {
+        TT.pending[pktseq/8] &= ~bit;
+        TT.recv++;
+      }
 
-    TT.recv++;
-    TT.fugit += (pkttime = millitime()-*(unsigned *)(ih+1));
+      // reply id == 0 for ipv4, 129 for ipv6
 
-    // reply id == 0 for ipv4, 129 for ipv6
+      if (len >= sizeof(*ih)+4) {
+        if ((pkttime = usec(tv)-*(unsigned *)(ih+1)) > INT_MAX) pkttime = 0;
+        if (!dup) {
+          TT.fugit += pkttime;
+          if (!TT.timed++ || pkttime<TT.min) TT.min = pkttime;
+          if (pkttime>TT.max) TT.max = pkttime;
+          TT.hist[hist_slot(pkttime)]++;
+        }
+      }
 
-    if (!(toys.optflags&FLAG_q)) {
-      if (toys.optflags&FLAG_f) xputc('\b');
-      else {
-        printf("%d bytes from %s: icmp_seq=%d ttl=%d", len, ntop(&srcaddr2.s),
-               ih->un.echo.sequence, 0);
-        if (len >= sizeof(*ih)+4)
-          printf(" time=%u ms", pkttime);
-        xputc('\n');
+      if (!(toys.optflags&FLAG_q)) {
+        if (toys.optflags&FLAG_f) {
+          if (!dup) xputc('\b');
+        } else {
+          printf("%d bytes from %s: icmp_seq=%d ttl=%d", len,
+                 ntop(&srcaddr2.s), pktseq, 0);
+          if (len >= sizeof(*ih)+4) {
+            print_ms(" time=", pkttime);
+            printf(" ms");
+          }
+          if (dup) printf(" (DUP!)");
+          xputc('\n');
+        }
       }
-    }
 
-    toys.exitval = 0;
+      toys.exitval = 0;
+    }
   }
 
   sigatexit(0);
@@ -25,70 +25,64 @@ config BASE64
 GLOBALS(
   long w;
 
-  unsigned total;
+  char *in, *out;
 )
 
-static void wraputchar(int c, int *x)
-{
-  putchar(c);
-  TT.total++;
-  if (TT.w && ++*x == TT.w) {
-    *x = 0;
-    xputc('\n');
-  };
-}
+// Input block size, a multiple of 3 so encoding only pads at EOF.
+#define B64_IN 49152
 
 static void do_base64(int fd, char *name)
 {
-  int out = 0, bits = 0, x = 0, i, len;
-  char *buf = toybuf+128;
-
-  TT.total = 0;
+  int len, left = 0, col = 0, olen, i, n;
+  unsigned state = 0;
+  char *o, *start, *enc;
 
   for (;;) {
-    // If no more data, flush buffer
-    if (!(len = xread(fd, buf, sizeof(toybuf)-128))) {
-      if (!(toys.optflags & FLAG_d)) {
-        if (bits) wraputchar(toybuf[out<<(6-bits)], &x);
-        while (TT.total&3) wraputchar('=', &x);
-        if (x) xputc('\n');
+    if (FLAG(d)) {
+      if (!(len = xread(fd, TT.in, B64_IN))) break;
+      n = len;
+      xwrite(1, TT.out, base64_decode(TT.out, TT.in, &n, &state, FLAG(i)));
+
+      // Stop at the = padding, complain about anything else
+      if (n<len) {
+        if (TT.in[n] != '=') error_msg("%s: bad input", name);
+        break;
       }
 
-      return;
+      continue;
     }
 
-    for (i=0; i<len; i++) {
-      if (toys.optflags & FLAG_d) {
-        if (buf[i] == '=') return;
-
-        if ((x = stridx(toybuf, buf[i])) != -1) {
-          out = (out<<6) + x;
-          bits += 6;
-          if (bits >= 8) {
-            putchar(out >> (bits -= 8));
-            out &= (1<<bits)-1;
-            if (ferror(stdout)) perror_exit(0);
-          }
-
-          continue;
-        }
-        if (buf[i] == '\n' || (toys.optflags & FLAG_i)) continue;
-
-        break;
-      } else {
-        out = (out<<8) + buf[i];
-        bits += 8;
-        while (bits >= 6) {
-          wraputchar(toybuf[out >> (bits -= 6)], &x);
-          out &= (1<<bits)-1;
+    // Encode whole groups until EOF, then the leftovers with padding
+    if (0>(len = readall(fd, TT.in+left, B64_IN-left))) perror_exit("%s", name);
+    n = len ? (len+left)-(len+left)%3 : left;
+    olen = base64_encode(enc = TT.out+2*B64_IN, TT.in, n);
+    memmove(TT.in, TT.in+n, left = len+left-n);
+
+    // Wrap a line at a time
+    if (!TT.w) start = enc, o = enc+olen;
+    else {
+      for (start = o = TT.out, i = 0; i<olen; ) {
+        n = minof(TT.w-col, olen-i);
+        memcpy(o, enc+i, n);
+        o += n;
+        i += n;
+        if ((col += n) == TT.w) {
+          *o++ = '\n';
+          col = 0;
         }
       }
+      if (!len && col) *o++ = '\n';
     }
+    xwrite(1, start, o-start);
+    if (!len) break;
   }
 }
 
 void base64_main(void)
 {
-  base64_init(toybuf);
+  // Encode into the top half of out, then wrap into the bottom half (which
+  // with -w 1 can be twice the encoded size).
+  TT.in = xmalloc(B64_IN);
+  TT.out = xmalloc(B64_IN*4);
   loopfiles(toys.optargs, do_base64);
 }
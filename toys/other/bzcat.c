@@ -52,7 +52,7 @@ config BZCAT
 #define SYMBOL_RUNB              1
 
 // Other housekeeping constants
-#define IOBUF_SIZE               4096
+#define IOBUF_SIZE               65536
 
 // Status return values
 #define RETVAL_LAST_BLOCK        (-100)
@@ -512,8 +512,9 @@ static int read_bunzip_data(struct bunzip_data *bd)
 static int write_bunzip_data(struct bunzip_data *bd, struct bwdata *bw,
   int out_fd, char *outbuf, int len)
 {
-  unsigned int *dbuf = bw->dbuf;
-  int count, pos, current, run, copies, outbyte, previous, gotcount = 0;
+  unsigned int *dbuf = bw->dbuf, crc, *crcTable = bd->crc32Table;
+  int count, pos, current, run, copies, outbyte, previous, gotcount = 0,
+    outPos;
 
   for (;;) {
     // If last read was short due to end of file, return last block now
@@ -530,16 +531,24 @@ static int write_bunzip_data(struct bunzip_data *bd, struct bwdata *bw,
       }
     }
 
-    // loop generating output
+    // loop generating output. Keep output position and crc in local
+    // variables: stores to the char output buffer could alias anything
+    // in *bd, so the compiler would otherwise reload them every byte.
     count = bw->writeCount;
     pos = bw->writePos;
     current = bw->writeCurrent;
     run = bw->writeRun;
+    crc = bw->dataCRC;
+    outPos = bd->outbufPos;
     while (count) {
 
       // If somebody (like tar) wants a certain number of bytes of
       // data from memory instead of written to a file, humor them.
-      if (len && bd->outbufPos >= len) goto dataus_interruptus;
+      if (len && outPos >= len) {
+        bd->outbufPos = outPos;
+        bw->dataCRC = crc;
+        goto dataus_interruptus;
+      }
       count--;
 
       // Follow sequence vector to undo Burrows-Wheeler transform.
@@ -561,16 +570,20 @@ static int write_bunzip_data(struct bunzip_data *bd, struct bwdata *bw,
 
       // Output bytes to buffer, flushing to file if necessary
       while (copies--) {
-        if (bd->outbufPos == IOBUF_SIZE) flush_bunzip_outbuf(bd, out_fd);
-        bd->outbuf[bd->outbufPos++] = outbyte;
-        bw->dataCRC = (bw->dataCRC << 8)
-                ^ bd->crc32Table[(bw->dataCRC >> 24) ^ outbyte];
+        if (outPos == IOBUF_SIZE) {
+          bd->outbufPos = outPos;
+          flush_bunzip_outbuf(bd, out_fd);
+          outPos = 0;
+        }
+        bd->outbuf[outPos++] = outbyte;
+        crc = (crc << 8) ^ crcTable[(crc >> 24) ^ outbyte];
       }
       if (current != previous) run=0;
     }
+    bd->outbufPos = outPos;
 
     // decompression of this block completed successfully
-    bw->dataCRC = ~(bw->dataCRC);
+    bw->dataCRC = ~crc;
     bd->totalCRC = ((bd->totalCRC << 1) | (bd->totalCRC >> 31)) ^ bw->dataCRC;
 
     // if this block had a crc error, force file level crc error.
@@ -599,6 +612,32 @@ dataus_interruptus:
   }
 }
 
+// Read "BZh" stream header and allocate intermediate buffer for its blocks.
+static int read_stream_header(struct bunzip_data *bd)
+{
+  unsigned int i;
+
+  // Ensure that file starts with "BZh".
+  for (i=0;i<3;i++) if (get_bits(bd,8)!="BZh"[i]) return RETVAL_NOT_BZIP_DATA;
+
+  // Next byte ascii '1'-'9', indicates block size in units of 100k of
+  // uncompressed data. Allocate intermediate buffer for block.
+  i = get_bits(bd, 8);
+  if (i<'1' || i>'9') return RETVAL_NOT_BZIP_DATA;
+  i = 100000*(i-'0')*THREADS;
+  if (i != bd->dbufSize) {
+    bd->dbufSize = i;
+    for (i=0; i<THREADS; i++) {
+      free(bd->bwdata[i].dbuf);
+      bd->bwdata[i].dbuf = xmalloc(bd->dbufSize * sizeof(int));
+    }
+  }
+  for (i=0; i<THREADS; i++) bd->bwdata[i].writeCount = 0;
+  bd->totalCRC = 0;
+
+  return 0;
+}
+
 // Allocate the structure, read file header. If !len, src_fd contains
 // filehandle to read from. Else inbuf contains data.
 static int start_bunzip(struct bunzip_data **bdp, int src_fd, char *inbuf,
@@ -624,34 +663,50 @@ static int start_bunzip(struct bunzip_data **bdp, int src_fd, char *inbuf,
 
   crc_init(bd->crc32Table, 0);
 
-  // Ensure that file starts with "BZh".
-  for (i=0;i<3;i++) if (get_bits(bd,8)!="BZh"[i]) return RETVAL_NOT_BZIP_DATA;
+  return read_stream_header(bd);
+}
 
-  // Next byte ascii '1'-'9', indicates block size in units of 100k of
-  // uncompressed data. Allocate intermediate buffer for block.
-  i = get_bits(bd, 8);
-  if (i<'1' || i>'9') return RETVAL_NOT_BZIP_DATA;
-  bd->dbufSize = 100000*(i-'0')*THREADS;
-  for (i=0; i<THREADS; i++)
-    bd->bwdata[i].dbuf = xmalloc(bd->dbufSize * sizeof(int));
+// Does another stream header follow the end of this stream? Discards the
+// padding bits at the end of the stream's last byte (get_bits() never holds
+// a whole byte it wasn't asked for, so that's all that's left).
+static int more_input(struct bunzip_data *bd)
+{
+  char *s;
+  int len;
 
-  return 0;
+  bd->inbufBitCount = 0;
+
+  // Look at the whole header before committing to it, short trailing junk
+  // mustn't hit get_bits()' EOF check.
+  while ((len = bd->inbufCount-bd->inbufPos) < 4 && bd->in_fd != -1) {
+    memmove(bd->inbuf, bd->inbuf+bd->inbufPos, len);
+    bd->inbufPos = 0;
+    bd->inbufCount = len;
+    if (0 >= (len = read(bd->in_fd, bd->inbuf+len, IOBUF_SIZE-len))) break;
+    bd->inbufCount += len;
+  }
+  s = bd->inbuf+bd->inbufPos;
+
+  return bd->inbufCount-bd->inbufPos>=4 && !memcmp(s, "BZh", 3)
+    && s[3]>='1' && s[3]<='9';
 }
 
-// Example usage: decompress src_fd to dst_fd. (Stops at end of bzip data,
-// not end of file.)
+// Example usage: decompress src_fd to dst_fd. Concatenated streams (as
+// written by pbzip2 or "cat a.bz2 b.bz2") decode as one, data after the
+// last stream that isn't another bzip2 stream is ignored.
 static char *bunzipStream(int src_fd, int dst_fd)
 {
   struct bunzip_data *bd;
   char *bunzip_errors[] = {0, "not bzip", "bad data", "old format"};
   int i, j;
 
-  if (!(i = start_bunzip(&bd,src_fd, 0, 0))) {
+  if (!(i = start_bunzip(&bd,src_fd, 0, 0))) for (;;) {
     i = write_bunzip_data(bd,bd->bwdata, dst_fd, 0, 0);
     if (i==RETVAL_LAST_BLOCK) {
       if (bd->bwdata[0].headerCRC==bd->totalCRC) i = 0;
       else i = RETVAL_DATA_ERROR;
     }
+    if (i || !more_input(bd) || (i = read_stream_header(bd))) break;
   }
   flush_bunzip_outbuf(bd, dst_fd);
 
@@ -2,48 +2,142 @@
  *
  * Copyright 2012 Rob Landley <rob@landley.net>
 
-USE_TAC(NEWTOY(tac, NULL, TOYFLAG_USR|TOYFLAG_BIN))
+USE_TAC(NEWTOY(tac, "rs:b", TOYFLAG_USR|TOYFLAG_BIN))
 
 config TAC
   bool "tac"
   default y
   help
-    usage: tac [FILE...]
+    usage: tac [-br] [-s SEP] [FILE...]
 
     Output lines in reverse order.
+
+    -b	Separator goes before the record instead of after
+    -r	SEP is a regular expression
+    -s	Use SEP to split records instead of newline
 */
 
+#define FOR_tac
 #include "toys.h"
+#include <sys/uio.h>
+
+GLOBALS(
+  char *s;
+
+  regex_t reg;
+  int iovlen, seplen;
+)
+
+// Queue len bytes at s for output with writev(), in batches of as many
+// iovecs as fit in toybuf. Call with len 0 to flush.
+static void tac_out(char *s, long len)
+{
+  struct iovec *iov = (void *)toybuf;
+  long ll;
+  int i = 0;
+
+  if (len) {
+    iov[TT.iovlen].iov_base = s;
+    iov[TT.iovlen++].iov_len = len;
+    if (TT.iovlen != sizeof(toybuf)/sizeof(*iov)) return;
+  }
+
+  while (i<TT.iovlen) {
+    if (0>(ll = writev(1, iov+i, TT.iovlen-i))) {
+      if (errno == EINTR) continue;
+      perror_exit("write");
+    }
+    for (; i<TT.iovlen && ll>=iov[i].iov_len; i++) ll -= iov[i].iov_len;
+    if (ll) {
+      iov[i].iov_base += ll;
+      iov[i].iov_len -= ll;
+    }
+  }
+  TT.iovlen = 0;
+}
+
+// Return end of last whole separator in [start, pos), or 0 if none
+static char *prev_sep(char *start, char *pos)
+{
+  char c = TT.s[TT.seplen-1], *p = start+TT.seplen-1;
+
+  while (pos>p)
+    if (*--pos == c && !memcmp(pos-TT.seplen+1, TT.s, TT.seplen-1))
+      return pos+1;
+
+  return 0;
+}
 
 static void do_tac(int fd, char *name)
 {
-  struct arg_list *list = NULL;
-  char *c;
+  struct stat st;
+  regmatch_t rm;
+  char *map = 0, *s, *e, *end;
+  long *off = 0, n = 0;
+  int tfd = -1, sep;
 
-  // Read in lines
-  for (;;) {
-    struct arg_list *temp;
-    long len;
+  // Spill pipes and such (including /proc files claiming to be empty, and
+  // anything else mmap won't take) to a deleted temp file and map that
+  if (fstat(fd, &st) || !S_ISREG(st.st_mode) || !st.st_size || MAP_FAILED
+      == (map = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0))) {
+    char *dir = getenv("TMPDIR"), *tempname,
+      *temp = xmprintf("%s/tac", dir ? dir : "/tmp");
 
-    if (!(c = get_rawline(fd, &len, '\n'))) break;
+    tfd = xtempfile(temp, &tempname);
+    unlink(tempname);
+    free(tempname);
+    free(temp);
+    xsendfile(fd, tfd);
+    fstat(fd = tfd, &st);
+    if (!st.st_size) map = 0;
+    else if (MAP_FAILED
+        == (map = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0))) {
+      perror_msg_raw(name);
+      map = 0;
+      goto done;
+    }
+  }
+  end = map+st.st_size;
 
-    temp = xmalloc(sizeof(struct arg_list));
-    temp->next = list;
-    temp->arg = c;
-    list = temp;
+  // A regex can't be searched backwards, so find all the matches first
+  if (FLAG(r)) for (s = map; s<end; ) {
+    if (regexec0(&TT.reg, s, end-s, 1, &rm, REG_NOTBOL*(s!=map))) break;
+    if (rm.rm_so == rm.rm_eo) {
+      s += rm.rm_so+1;
+      continue;
+    }
+    if (!(n&255)) off = xrealloc(off, (n+256)*2*sizeof(long));
+    off[2*n] = s-map+rm.rm_so;
+    off[2*n+1] = s-map+rm.rm_eo;
+    n++;
+    s += rm.rm_eo;
   }
 
-  // Play them back.
-  while (list) {
-    struct arg_list *temp = list->next;
-    xprintf("%s", list->arg);
-    free(list->arg);
-    free(list);
-    list = temp;
+  // Walk back from the end one record at a time. Without -b a record ends
+  // with its separator, with -b it starts with it. Either way the previous
+  // separator has to end before this record's separator starts.
+  sep = end-map>=TT.seplen && !memcmp(end-TT.seplen, TT.s, TT.seplen);
+  for (e = end; e>map; e = s, sep = 1) {
+    if (FLAG(r)) {
+      while (n && map+off[2*n-1-!!FLAG(b)]>=e) n--;
+      s = n ? map+off[2*n-1-!!FLAG(b)] : map;
+    } else if (FLAG(b)) s = (s = prev_sep(map, e)) ? s-TT.seplen : map;
+    else if (!(s = prev_sep(map, e-TT.seplen*sep))) s = map;
+    tac_out(s, e-s);
   }
+  tac_out(0, 0);
+
+done:
+  if (map) munmap(map, st.st_size);
+  free(off);
+  if (tfd != -1) close(tfd);
 }
 
 void tac_main(void)
 {
+  if (!TT.s) TT.s = "\n";
+  if (!(TT.seplen = strlen(TT.s))) error_exit("empty separator");
+  if (FLAG(r)) xregcomp(&TT.reg, TT.s, 0);
+
   loopfiles(toys.optargs, do_tac);
 }
@@ -36,140 +36,191 @@ config XXD
 
 GLOBALS(
   long s, g, o, l, c;
+
+  long long pos;
+  signed char unhex[256];
 )
 
+#define XXD_BUF 65536
+
+static char *hex = "0123456789abcdef";
+
+// Format whole lines into a buffer by hand and write them out in batches.
 static void do_xxd(int fd, char *name)
 {
-  long long pos = 0;
-  long long limit = TT.l;
-  int i, len, space;
+  long long pos = 0, limit = TT.l;
+  int lines = XXD_BUF/TT.c, i, j, n, len, space;
+  unsigned char *in = xmalloc(lines*TT.c), *s;
+  char *out = xmalloc(lines*(4*TT.c+20)), *o;
 
-  if (toys.optflags&FLAG_s) {
+  if (FLAG(s)) {
     xlseek(fd, TT.s, SEEK_SET);
     pos = TT.s;
     if (limit) limit += TT.s;
   }
 
-  while (0<(len = readall(fd, toybuf,
-                          (limit && limit-pos<TT.c)?limit-pos:TT.c))) {
-    if (!(toys.optflags&FLAG_p)) printf("%08llx: ", TT.o + pos);
-    pos += len;
-    space = 2*TT.c+TT.c/TT.g+1;
-
-    for (i=0; i<len;) {
-      space -= printf("%02x", toybuf[i]);
-      if (!(++i%TT.g)) {
-        putchar(' ');
-        space--;
+  while (0<(len = readall(fd, in,
+                   (limit && limit-pos<lines*TT.c) ? limit-pos : lines*TT.c))) {
+    for (o = out, s = in; len>0; s += TT.c, len -= TT.c) {
+      n = minof(len, TT.c);
+
+      // Offset is at least 8 hex digits
+      if (!FLAG(p)) {
+        unsigned long long off = TT.o+pos;
+
+        for (i = 16; i>8 && !(off>>(4*(i-1))); i--);
+        while (i--) *o++ = hex[(off>>(4*i))&15];
+        *o++ = ':';
+        *o++ = ' ';
+      }
+      pos += n;
+      space = 2*TT.c+TT.c/TT.g+1;
+
+      for (i = 0, j = TT.g; i<n; i++) {
+        *o++ = hex[s[i]>>4];
+        *o++ = hex[s[i]&15];
+        space -= 2;
+        if (!--j && !FLAG(p)) {
+          *o++ = ' ';
+          space--;
+          j = TT.g;
+        }
       }
-    }
 
-    if (!(toys.optflags&FLAG_p)) {
-      printf("%*s", space, "");
-      for (i=0; i<len; i++)
-        putchar((toybuf[i]>=' ' && toybuf[i]<='~') ? toybuf[i] : '.');
+      if (!FLAG(p)) {
+        memset(o, ' ', space);
+        o += space;
+        for (i = 0; i<n; i++) *o++ = (s[i]>=' ' && s[i]<='~') ? s[i] : '.';
+      }
+      *o++ = '\n';
     }
-    putchar('\n');
+    xwrite(1, out, o-out);
   }
   if (len<0) perror_exit("read");
+
+  if (CFG_TOYBOX_FREE) {
+    free(in);
+    free(out);
+  }
 }
 
 static void do_xxd_include(int fd, char *name)
 {
-  long long total = 0;
   int c = 1, i, len;
+  char *out = xmalloc(8*sizeof(toybuf)), *o;
 
   // The original xxd outputs a header/footer if given a filename (not stdin).
   // We don't, which means that unlike the original we can implement -ri.
   while ((len = read(fd, toybuf, sizeof(toybuf))) > 0) {
-    total += len;
-    for (i = 0; i < len; ++i) {
-      printf("%s%#.02x", c > 1 ? ", " : "  ", toybuf[i]);
+    for (o = out, i = 0; i < len; ++i) {
+      *o++ = c>1 ? ',' : ' ';
+      *o++ = ' ';
+      *o++ = '0';
+      *o++ = 'x';
+      *o++ = hex[(unsigned char)toybuf[i]>>4];
+      *o++ = hex[toybuf[i]&15];
       if (c++ == TT.c) {
-        xprintf(",\n");
+        *o++ = ',';
+        *o++ = '\n';
         c = 1;
       }
     }
+    xwrite(1, out, o-out);
   }
   if (len < 0) perror_msg_raw(name);
-  if (c > 1) xputc('\n');
+  if (c > 1) xwrite(1, "\n", 1);
+  free(out);
 }
 
-static int dehex(char ch)
+// Append a byte to the -r output, seeking first if a dump line said to.
+static void xxd_byte(char **o, int byte)
 {
-  if (ch >= '0' && ch <= '9') return ch - '0';
-  if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
-  if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
-  return (ch == '\n') ? -2 : -1;
+  if (*o == toybuf+sizeof(toybuf)) xwrite(1, *o = toybuf, sizeof(toybuf));
+  *(*o)++ = byte;
+  TT.pos++;
 }
 
 static void do_xxd_reverse(int fd, char *name)
 {
   FILE *fp = xfdopen(fd, "r");
-  int tmp;
+  char *line = 0, *o = toybuf;
+  unsigned char *s;
+  size_t size = 0;
+  int col, n1, n2;
+
+  while (getline(&line, &size, fp) > 0) {
+    s = (void *)line;
 
-  if (toys.optflags&FLAG_i) {
     // -ri is a very easy special case.
-    while (fscanf(fp, " 0x%02x,", &tmp) == 1) {
-      fputc(tmp & 0xff, stdout);
-    }
-  } else {
-    while (!feof(fp)) {
-      int col = 0;
-
-      // Each line of a regular hexdump starts with an offset/address.
-      // Each line of a plain hexdump just goes straight into the bytes.
-      if (!(toys.optflags&FLAG_p)) {
-        long long pos;
-
-        if (fscanf(fp, "%llx: ", &pos) == 1) {
-          if (fseek(stdout, pos, SEEK_SET) != 0) {
-            // TODO: just write out zeros if non-seekable?
-            perror_exit("%s: seek failed", name);
-          }
+    if (FLAG(i)) {
+      for (;;) {
+        while (isspace(*s)) s++;
+        if (!*s) break;
+        if (*s++ != '0' || *s++ != 'x' || (n1 = TT.unhex[*s++]) < 0) goto done;
+        if ((n2 = TT.unhex[*s]) >= 0) {
+          n1 = (n1<<4)|n2;
+          s++;
         }
+        xxd_byte(&o, n1);
+        if (*s == ',') s++;
       }
 
-      // A plain hexdump can have as many bytes per line as you like,
-      // but a non-plain hexdump assumes garbage after it's seen the
-      // specified number of bytes.
-      while (toys.optflags&FLAG_p || col < TT.c) {
-        int n1, n2;
-
-        // If we're at EOF or EOL or we read some non-hex...
-        if ((n1 = n2 = dehex(fgetc(fp))) < 0 || (n2 = dehex(fgetc(fp))) < 0) {
-          // If we're at EOL, start on that line.
-          if (n1 == -2 || n2 == -2) continue;
-          // Otherwise, skip to the next line.
-          break;
-        }
-
-        fputc((n1 << 4) | (n2 & 0xf), stdout);
-        col++;
+      continue;
+    }
 
-        // Is there any grouping going on? Ignore a single space.
-        tmp = fgetc(fp);
-        if (tmp != ' ') ungetc(tmp, fp);
+    // Each line of a regular hexdump starts with an offset/address.
+    // Each line of a plain hexdump just goes straight into the bytes.
+    if (!FLAG(p)) {
+      unsigned char *start;
+      long long pos = 0;
+
+      while (isspace(*s)) s++;
+      for (start = s; (n1 = TT.unhex[*s]) >= 0; s++) pos = (pos<<4)|n1;
+      if (s == start || *s != ':') s = start;
+      else {
+        while (isspace(*++s));
+        if (pos != TT.pos) {
+          xwrite(1, toybuf, o-toybuf);
+          o = toybuf;
+          // TODO: just write out zeros if non-seekable?
+          if (-1 == lseek(1, TT.pos = pos, SEEK_SET))
+            perror_exit("%s: seek failed", name);
+        }
       }
+    }
 
-      // Skip anything else on this line (such as the ASCII dump).
-      while ((tmp = fgetc(fp)) != EOF && tmp != '\n')
-        ;
+    // A plain hexdump can have as many bytes per line as you like,
+    // but a non-plain hexdump assumes garbage after it's seen the
+    // specified number of bytes. Ignore a single space (grouping) and
+    // skip anything else on this line (such as the ASCII dump).
+    for (col = 0; FLAG(p) || col<TT.c; col++) {
+      if ((n1 = TT.unhex[*s]) < 0 || (n2 = TT.unhex[s[1]]) < 0) break;
+      xxd_byte(&o, (n1<<4)|n2);
+      s += 2+(s[2] == ' ');
     }
   }
+done:
+  xwrite(1, toybuf, o-toybuf);
 
   if (ferror(fp)) perror_msg_raw(name);
   fclose(fp);
+  free(line);
 }
 
 void xxd_main(void)
 {
+  int i;
+
   if (TT.c < 0 || TT.c > 256) error_exit("invalid -c: %ld", TT.c);
   if (TT.c == 0) TT.c = (toys.optflags&FLAG_i)?12:16;
 
   // Plain style is 30 bytes/line, no grouping.
   if (toys.optflags&FLAG_p) TT.c = TT.g = 30;
 
+  // Hex digit values for -r, -1 for everything else.
+  memset(TT.unhex, -1, 256);
+  for (i = 0; i<22; i++) TT.unhex["0123456789abcdefABCDEF"[i]] = i-6*(i>15);
+
   loopfiles(toys.optargs,
     toys.optflags&FLAG_r ? do_xxd_reverse
       : (toys.optflags&FLAG_i ? do_xxd_include : do_xxd));
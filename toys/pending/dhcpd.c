@@ -194,6 +194,14 @@ typedef struct {
   uint8_t pad[2];
 } dyn_lease;
 
+// In-memory IPv4 lease: the record saved in the lease file, plus hash chains
+// to find it by MAC and by IP, and the list of leases not yet saved.
+typedef struct lease4_s {
+  dyn_lease dl;
+  struct lease4_s *bymac, *byip, *dirty;
+  uint8_t isdirty;
+} lease4;
+
 typedef struct {
   uint16_t duid_len;
   uint16_t ia_type;
@@ -286,6 +294,13 @@ typedef struct __attribute__((__may_alias__)) server_state_s {
     static_lease6 *sleases6;
   } leases;
   struct arg_list *dleases;
+  // IPv4 lease index: hash tables of hashmask+1 chains, bitmaps of pool
+  // addresses that have a lease or are static and of the static ones alone,
+  // and lease file journal state
+  lease4 **bymac, **byip, *dirty;
+  unsigned long *inuse, *statics;
+  uint32_t hashmask, journal, nleases, stamp;
+  uint8_t compact;
 } server_state_t;
 
 static option_val_t options_list[] = {
@@ -1191,40 +1206,66 @@ static void run_notify(char **argv)
   dbg("script complete.\n");
 }
 
+// Save IPv4 leases. The lease file is a timestamp followed by records with
+// expiry times relative to it, and later records for the same MAC replace
+// earlier ones. So while the file is recent and not mostly stale records,
+// just append the leases that changed. Otherwise rewrite it from scratch.
 static void write_leasefile(void)
 {
-  int fd;
-  uint32_t curr, tmp_time;
+  int fd, i, len = 0, per = sizeof(toybuf)/sizeof(dyn_lease);
+  uint32_t now = time(NULL);
   int64_t timestamp;
-  struct arg_list *listdls = gstate.dleases;
-  dyn_lease *dls;
+  lease4 *l, *next = 0;
+  dyn_lease *dls = (void *)toybuf;
+
+  if (now-gstate.stamp > 60*60 || gstate.journal > 2*gstate.nleases+64)
+    gstate.compact = 1;
+  if (!gstate.compact && !gstate.dirty) return;
 
-  if ((fd = open(gconfig.lease_file, O_WRONLY | O_CREAT | O_TRUNC, 0600)) < 0) {
+  if ((fd = open(gconfig.lease_file, O_WRONLY | O_CREAT
+      | (gstate.compact ? O_TRUNC : O_APPEND), 0600)) < 0) {
     perror_msg("can't open %s ", gconfig.lease_file);
-  } else {
-    curr = timestamp = time(NULL);
-    timestamp = SWAP_BE64(timestamp);
+    return;
+  }
+  if (gstate.compact) {
+    timestamp = SWAP_BE64((int64_t)now);
     writeall(fd, &timestamp, sizeof(timestamp));
+    gstate.stamp = now;
+    gstate.journal = 0;
+  }
 
-    while (listdls) {
-      dls = (dyn_lease*)listdls->arg;
-      tmp_time = dls->expires;
-      dls->expires -= curr;
-      if ((int32_t) dls->expires < 0) goto skip;
-      dls->expires = htonl(dls->expires);
-      writeall(fd, dls, sizeof(dyn_lease));
-skip:
-      dls->expires = tmp_time;
-      listdls = listdls->next;
+  // Walk every chain of the IP hash when compacting, else the dirty list.
+  for (i = 0, l = gstate.compact ? 0 : gstate.dirty;;) {
+    if (!l) {
+      if (!gstate.compact || i > gstate.hashmask) break;
+      l = gstate.byip[i++];
+      continue;
     }
-    close(fd);
-    if (gconfig.notify_file) {
-      char *argv[3];
-      argv[0] = gconfig.notify_file;
-      argv[1] = gconfig.lease_file;
-      argv[2] = NULL;
-      run_notify(argv);
+    next = gstate.compact ? l->byip : l->dirty;
+    l->isdirty = 0;
+
+    // Changed leases are saved even when expired, to replace older records
+    if (!gstate.compact || (int32_t)(l->dl.expires - now) >= 0) {
+      dls[len] = l->dl;
+      dls[len].expires = htonl(l->dl.expires - gstate.stamp);
+      if (++len == per) {
+        writeall(fd, dls, len*sizeof(dyn_lease));
+        len = 0;
+      }
+      gstate.journal++;
     }
+    l = next;
+  }
+  writeall(fd, dls, len*sizeof(dyn_lease));
+  gstate.dirty = 0;
+  gstate.compact = 0;
+  close(fd);
+  if (gconfig.notify_file) {
+    char *argv[3];
+    argv[0] = gconfig.notify_file;
+    argv[1] = gconfig.lease_file;
+    argv[2] = NULL;
+    run_notify(argv);
   }
 }
 
@@ -1326,20 +1367,95 @@ static int verifyip6_in_lease(uint8_t *nip6, uint8_t *duid, uint16_t ia_type, ui
   return 0;
 }
 
+static lease4 **find_lease_mac(uint8_t mac[6])
+{
+  lease4 **ll;
+  unsigned i, hash = 2166136261;
+
+  for (i = 0; i < 6; i++) hash = (hash^mac[i])*16777619;
+  for (ll = gstate.bymac+(hash&gstate.hashmask); *ll; ll = &(*ll)->bymac)
+    if (!memcmp((*ll)->dl.lease_mac, mac, 6)) break;
+
+  return ll;
+}
+
+// Consecutive addresses land in consecutive chains.
+static lease4 **find_lease_ip(uint32_t nip)
+{
+  lease4 **ll;
+
+  for (ll = gstate.byip+(ntohl(nip)&gstate.hashmask); *ll; ll = &(*ll)->byip)
+    if ((*ll)->dl.lease_nip == nip) break;
+
+  return ll;
+}
+
+// Mark or clear an address in the pool bitmap. Static addresses stay marked.
+static void mark_inuse(uint32_t nip, int used)
+{
+  unsigned long bit, ip = ntohl(nip);
+
+  if (ip < gconfig.start_ip || ip > gconfig.end_ip) return;
+  ip -= gconfig.start_ip;
+  bit = 1UL<<(ip%(8*sizeof(long)));
+  ip /= 8*sizeof(long);
+  if (used) gstate.inuse[ip] |= bit;
+  else if (gstate.statics) gstate.inuse[ip] &= ~bit | gstate.statics[ip];
+}
+
+// Set up the IPv4 lease index for the configured pool.
+static void init_leases(void)
+{
+  uint32_t size = gconfig.end_ip-gconfig.start_ip+1, bits = 8*sizeof(long),
+    words = (size+bits-1)/bits, i;
+  static_lease *sls;
+
+  for (i = 64; i < size/2 && i < (1<<20); i <<= 1);
+  gstate.hashmask = i-1;
+  gstate.bymac = xzalloc(i*sizeof(lease4 *));
+  gstate.byip = xzalloc(i*sizeof(lease4 *));
+
+  // Bits past the end of the pool count as in use.
+  gstate.inuse = xzalloc(words*sizeof(long));
+  if (size%bits) gstate.inuse[words-1] = ~0UL<<(size%bits);
+  for (sls = gstate.leases.sleases; sls; sls = sls->next)
+    mark_inuse(sls->nip, 1);
+  gstate.statics = xmemdup(gstate.inuse, words*sizeof(long));
+}
+
+static void dirty_lease(lease4 *l)
+{
+  if (l->isdirty) return;
+  l->isdirty = 1;
+  l->dirty = gstate.dirty;
+  gstate.dirty = l;
+}
+
+// Remove lease from the index and free it.
+static void del_lease(lease4 *l)
+{
+  lease4 **ll;
+
+  *find_lease_mac(l->dl.lease_mac) = l->bymac;
+  *find_lease_ip(l->dl.lease_nip) = l->byip;
+  if (l->isdirty) {
+    for (ll = &gstate.dirty; *ll != l; ll = &(*ll)->dirty);
+    *ll = l->dirty;
+  }
+  mark_inuse(l->dl.lease_nip, 0);
+  gstate.nleases--;
+  free(l);
+}
+
 // Verify ip NIP in current leases ( assigned or not)
 static int verifyip_in_lease(uint32_t nip, uint8_t mac[6])
 {
   static_lease *sls;
-  struct arg_list *listdls;
+  lease4 *l;
 
-  for (listdls = gstate.dleases; listdls; listdls = listdls->next) {
-    if (((dyn_lease*) listdls->arg)->lease_nip == nip) {
-      if (((int32_t)(((dyn_lease*) listdls->arg)->expires) - time(NULL)) < 0)
-        return 0;
-      return -1;
-    }
-    if (!memcmp(((dyn_lease*) listdls->arg)->lease_mac, mac, 6)) return -1;
-  }
+  if ((l = *find_lease_ip(nip)) && (int32_t)(l->dl.expires - time(NULL)) >= 0)
+    return -1;
+  if ((l = *find_lease_mac(mac)) && l->dl.lease_nip != nip) return -1;
   for (sls = gstate.leases.sleases; sls; sls = sls->next)
     if (sls->nip == nip) return -2;
 
@@ -1352,31 +1468,36 @@ static int verifyip_in_lease(uint32_t nip, uint8_t mac[6])
 // add ip assigned_nip to dynamic lease.
 static int addip_to_lease(uint32_t assigned_nip, uint8_t mac[6], uint32_t *req_exp, char *hostname, uint8_t update)
 {
-  dyn_lease *dls;
-  struct arg_list *listdls = gstate.dleases;
+  lease4 *l, **ll;
   uint32_t now = time(NULL);
 
-  while (listdls) {
-    if (!memcmp(((dyn_lease*) listdls->arg)->lease_mac, mac, 6)) {
-      if (update) *req_exp = get_lease(*req_exp + ((dyn_lease*) listdls->arg)->expires);
-      ((dyn_lease*) listdls->arg)->expires = *req_exp + now;
-      return 0;
-    }
-    listdls = listdls->next;
+  if ((l = *(ll = find_lease_mac(mac)))) {
+    if (update) *req_exp = get_lease(*req_exp + l->dl.expires);
+    l->dl.expires = *req_exp + now;
+    dirty_lease(l);
+    return 0;
   }
 
-  dls = xzalloc(sizeof(dyn_lease));
-  memcpy(dls->lease_mac, mac, 6);
-  dls->lease_nip = assigned_nip;
-  if (hostname) memcpy(dls->hostname, hostname, 20);
+  // An expired lease on this address (or any, when loading the lease file)
+  // makes way for the new one. A live one belongs to somebody else.
+  if ((l = *find_lease_ip(assigned_nip))) {
+    if (update && (int32_t)(l->dl.expires - now) >= 0) return -1;
+    del_lease(l);
+    ll = find_lease_mac(mac);
+  }
+
+  *ll = l = xzalloc(sizeof(lease4));
+  memcpy(l->dl.lease_mac, mac, 6);
+  l->dl.lease_nip = assigned_nip;
+  if (hostname) memcpy(l->dl.hostname, hostname, 20);
 
   if (update) *req_exp = get_lease(*req_exp + now);
-  dls->expires = *req_exp + now;
+  l->dl.expires = *req_exp + now;
 
-  listdls = xzalloc(sizeof(struct arg_list));
-  listdls->next = gstate.dleases;
-  listdls->arg = (char*)dls;
-  gstate.dleases = listdls;
+  *find_lease_ip(assigned_nip) = l;
+  mark_inuse(assigned_nip, 1);
+  gstate.nleases++;
+  dirty_lease(l);
 
   return 0;
 }
@@ -1417,16 +1538,49 @@ static int addip6_to_lease(uint8_t *assigned_nip, uint8_t *duid, uint16_t duid_l
 // delete ip assigned_nip from dynamic lease.
 static int delip_from_lease(uint32_t assigned_nip, uint8_t mac[6], uint32_t del_time)
 {
-  struct arg_list *listdls = gstate.dleases;
+  lease4 *l = *find_lease_mac(mac);
 
-  while (listdls) {
-    if (!memcmp(((dyn_lease*) listdls->arg)->lease_mac, mac, 6)) {
-      ((dyn_lease*) listdls->arg)->expires = del_time + time(NULL);
-      return 0;
+  if (!l) return -1;
+  l->dl.expires = del_time + time(NULL);
+  dirty_lease(l);
+
+  return 0;
+}
+
+// Lowest pool address without a lease that isn't static. If there are none,
+// drop the expired leases and look again.
+static uint32_t getip_from_bitmap(void)
+{
+  uint32_t size = gconfig.end_ip-gconfig.start_ip+1, bits = 8*sizeof(long),
+    now = time(NULL), i, j, nip;
+  static_lease *sls;
+  lease4 **ll;
+
+  for (;;) {
+    for (i = 0; i < (size+bits-1)/bits; i++) {
+      while (~gstate.inuse[i]) {
+        for (j = 0; gstate.inuse[i]&(1UL<<j); j++);
+        nip = htonl(gconfig.start_ip+i*bits+j);
+        for (sls = gstate.leases.sleases; sls; sls = sls->next)
+          if (sls->nip == nip) break;
+        if (!sls) return nip;
+        gstate.statics[i] |= 1UL<<j;
+        gstate.inuse[i] |= 1UL<<j;
+      }
     }
-    listdls = listdls->next;
+    if (!gstate.nleases) return 0;
+
+    for (i = j = 0; i <= gstate.hashmask; i++) {
+      for (ll = gstate.byip+i; *ll;) {
+        if ((int32_t)((*ll)->dl.expires - now) >= 0) ll = &(*ll)->byip;
+        else {
+          del_lease(*ll);
+          j++;
+        }
+      }
+    }
+    if (!j) return 0;
   }
-  return -1;
 }
 
 // returns a IP from static, dynamic leases or free ip pool, 0 otherwise.
@@ -1434,24 +1588,14 @@ static uint32_t getip_from_pool(uint32_t req_nip, uint8_t mac[6], uint32_t *req_
 {
   uint32_t nip = 0;
   static_lease *sls = gstate.leases.sleases;
-  struct arg_list *listdls = gstate.dleases, *tmp = NULL;
+  lease4 *l;
 
   if (req_nip && (!verifyip_in_lease(req_nip, mac))) nip = req_nip;
 
-  if (!nip) {
-    while (listdls) {
-      if (!memcmp(((dyn_lease*)listdls->arg)->lease_mac, mac, 6)) {
-        nip = ((dyn_lease*)listdls->arg)->lease_nip;
-        if (tmp) tmp->next = listdls->next;
-        else gstate.dleases = listdls->next;
-        free(listdls->arg);
-        free(listdls);
-        if (verifyip_in_lease(nip, mac) < 0) nip = 0;
-        break;
-      }
-      tmp = listdls;
-      listdls = listdls->next;
-    }
+  if (!nip && (l = *find_lease_mac(mac))) {
+    nip = l->dl.lease_nip;
+    del_lease(l);
+    if (verifyip_in_lease(nip, mac) < 0) nip = 0;
   }
   if (!nip) {
     while (sls) {
@@ -1462,18 +1606,16 @@ static uint32_t getip_from_pool(uint32_t req_nip, uint8_t mac[6], uint32_t *req_
       sls = sls->next;
     }
   }
-  if (!nip) {
-    for (nip = htonl(gconfig.start_ip); ntohl(nip) <= gconfig.end_ip; ) {
-      if (!verifyip_in_lease(nip, mac)) break;
-      nip = ntohl(nip);
-      nip = htonl(++nip);
-    }
-    if (ntohl(nip) > gconfig.end_ip) {
-      nip = 0;
-      infomsg(infomode, "can't find free IP in IP Pool.");
-    }
+  if (!nip && !(nip = getip_from_bitmap())) {
+    infomsg(infomode, "can't find free IP in IP Pool.");
+
+    // Don't let a saved record bring back a lease we just dropped
+    gstate.compact = 1;
+  }
+  if (nip && addip_to_lease(nip, mac, req_exp, hostname, 1)) {
+    infomsg(infomode, "IP for static lease in use by another client.");
+    nip = 0;
   }
-  if (nip) addip_to_lease(nip, mac, req_exp, hostname, 1);
   return nip;
 }
 
@@ -1545,9 +1687,12 @@ static void read_leasefile(void)
   int32_t tmp_time;
   int64_t timestamp;
   dyn_lease *dls;
+  lease4 *l;
   int fd = open(gconfig.lease_file, O_RDONLY);
 
   dls = xzalloc(sizeof(dyn_lease));
+  init_leases();
+  gstate.compact = 1;
 
   if (read(fd, &timestamp, sizeof(timestamp)) != sizeof(timestamp))
     goto lease_error_exit;
@@ -1555,17 +1700,25 @@ static void read_leasefile(void)
   timestamp = SWAP_BE64(timestamp);
   passed = time(NULL) - timestamp;
   if ((uint64_t)passed > 12 * 60 * 60) goto lease_error_exit;
+  gstate.stamp = timestamp;
+  gstate.compact = 0;
 
+  // Later records replace earlier ones for the same MAC or IP.
   while (read(fd, dls, sizeof(dyn_lease)) == sizeof(dyn_lease)) {
+    gstate.journal++;
     ip = ntohl(dls->lease_nip);
     if (ip >= gconfig.start_ip && ip <= gconfig.end_ip) {
       tmp_time = ntohl(dls->expires) - passed;
+      if ((l = *find_lease_mac(dls->lease_mac))
+          && (tmp_time < 0 || l->dl.lease_nip != dls->lease_nip)) del_lease(l);
       if (tmp_time < 0) continue;
       addip_to_lease(dls->lease_nip, dls->lease_mac,
           (uint32_t*)&tmp_time, dls->hostname, 0);
     }
   }
 lease_error_exit:
+  for (l = gstate.dirty; l; l = l->dirty) l->isdirty = 0;
+  gstate.dirty = 0;
   free(dls);
   close(fd);
 }
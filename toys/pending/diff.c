@@ -3,7 +3,8 @@
  * Copyright 2014 Sandeep Sharma <sandeep.jack2756@gmail.com>
  * Copyright 2014 Ashwini Kumar <ak.ashwini1981@gmail.com>
  *
- * See: http://cm.bell-labs.com/cm/cs/cstr/41.pdf
+ * See: http://www.xmailserver.org/diff2.pdf (Myers, "An O(ND) Difference
+ *   Algorithm and Its Variations")
 
 USE_DIFF(NEWTOY(diff, "<2>2(color)B(ignore-blank-lines)d(minimal)b(ignore-space-change)ut(expand-tabs)w(ignore-all-space)i(ignore-case)T(initial-tab)s(report-identical-files)q(brief)a(text)L(label)*S(starting-file):N(new-file)r(recursive)U(unified)#<0=3", TOYFLAG_USR|TOYFLAG_BIN|TOYFLAG_ARGFAIL(2)))
 
@@ -41,7 +42,7 @@ GLOBALS(
   struct arg_list *L_list;
 
   int dir_num, size, is_binary, status, change, len[2];
-  int *offset[2];
+  long *offset[2];
   struct stat st[2];
 )
 
@@ -49,15 +50,6 @@ GLOBALS(
 #define MAX(x,y) ((x) > (y) ? (x) : (y))
 #define IS_STDIN(s)     ((s)[0] == '-' && !(s)[1])
 
-struct v_vector {
-  unsigned serial:31;
-  unsigned last:1;
-  union {
-    unsigned hash;
-    unsigned p;
-  };
-};
-
 struct diff {
   long a, b, c, d, prev, suff;
 };
@@ -67,14 +59,10 @@ static struct dir_t {
   int nr_elm;
 } dir[2];
 
-struct candidate {
-  int a, b;
-  struct candidate *prev, *next;
-};
-
 static struct file_t {
-  FILE *fp;
-  int len;
+  char *data;
+  long size;
+  int len, mapped;
 } file[2];
 
 enum {
@@ -89,123 +77,58 @@ enum {
   space = 1 << 12
 };
 
-static int comp(const void *a, const void* b)
-{
-  int i = ((struct v_vector *)a)->hash -
-    ((struct v_vector *)b)->hash;
-
-  if (!i) i = ((struct v_vector *)a)->serial -
-    ((struct v_vector *)b)->serial;
-  return i;
-}
-
-static int search (struct candidate **K, int r, int k, int j)
+// Map (or for pipes and such, read) whole file into file[i], closing fd.
+// Returns 0 on read error.
+static int load_file(int i, int fd, struct stat *st)
 {
-  int low = r, upper = k, mid;
-
-  mid = (low + upper) / 2;
-  while (low <= mid) {
-    if (((struct candidate*)(K[mid]))->b < j &&
-        ((struct candidate*)(K[mid + 1]))->b > j)
-      return mid;
-
-    if (((struct candidate*)(K[mid]))->b < j) low = mid + 1;
-    else if (((struct candidate*)(K[mid]))->b > j) upper = mid - 1;
-    else return -1;
-
-    mid = (low + upper) / 2;
+  long len = 0, cap;
+
+  file[i].mapped = 0;
+  file[i].size = 0;
+  file[i].data = 0;
+  if (S_ISREG(st->st_mode) && st->st_size) {
+    file[i].data = mmap(0, st->st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (file[i].data != MAP_FAILED) {
+      file[i].size = st->st_size;
+      file[i].mapped = 1;
+      madvise(file[i].data, file[i].size, MADV_SEQUENTIAL);
+    } else file[i].data = 0;
   }
-  return -1;
-}
-
-static struct candidate * new_candidate (int i, int j, struct candidate* prev)
-{
-  struct candidate *c = xzalloc(sizeof(struct candidate));
-
-  c->a = i;
-  c->b = j;
-  c->prev = prev;
-  return c;
-}
-
-
-static void free_candidates(struct candidate *c)
-{
-  struct candidate *t = c;
-  
-  while ((t = c)) {
-    c = c->next;
-    free(t);
+  if (!file[i].mapped) for (cap = 0;;) {
+    if (file[i].size == cap)
+      file[i].data = xrealloc(file[i].data, cap = cap*2+65536);
+    len = read(fd, file[i].data+file[i].size, cap-file[i].size);
+    if (len < 1) break;
+    file[i].size += len;
   }
-}
-/*
- * 1. Search K[r: k] for an element K[s] such that K[s]-> b < j and K[s + 1]->b > j
- * 2. if found do
- *  2.a. If K[s + 1]->b > j do K[r] = c; r = s+1 and c = candidate(i, j, K[s]) //we have a candidate
- *  2.b. if s = k (fence reached move it further) do K[k + 2] = K[k + 1], k++
- * 3. if E[p].last true break i.e we have reached at the end of an equiv class
- *    else p = p + 1 //keep traversing the equiv class.
- * 4. K[r] = c //Save the sucessfully filled k-candidate.
- */
-static void  do_merge(struct candidate **K, int *k, int i,
-    struct v_vector *E, int p)
-{
-  int r = 0, s, j;
-  struct candidate *pr = 0, *c = K[0];
-
-  while (1) {
-    j = E[p].serial;
-    s = search(K, r, *k, j);
-    if (s >= 0 && (((struct candidate*)(K[s]))->b < j &&
-          ((struct candidate*)(K[s + 1]))->b > j)) {
-
-      if (((struct candidate*)(K[s + 1]))->b > j) {
-        pr = K[s];
-        if (r && K[r]) c->next = K[r];
-        K[r] = c;
-        r = s + 1;
-        c = new_candidate(i , j, pr);
-      }
-      if (s == *k) {
-        K[*k + 2] = K[*k + 1];
-        *k = *k + 1;
-        break;
-      }
-    }
-    if (E[p].last) break;
-    else p = p + 1;
-  }
-  K[r] = c;
+  if (fd) close(fd);
+
+  return !len;
 }
 
-static FILE* read_stdin()
+static void unload_files(void)
 {
-  char tmp_name[] = "/tmp/diffXXXXXX";
-  int rd, wr, tmpfd = mkstemp(tmp_name);
-
-  if (tmpfd == -1) perror_exit("mkstemp");
-  unlink(tmp_name);
-
-  while (1) {
-    rd = xread(STDIN_FILENO, toybuf, sizeof(toybuf));
+  int i;
 
-    if (!rd) break;
-    if (rd < 0) perror_exit("read error");
-    wr = writeall(tmpfd, toybuf, rd);
-    if (wr < 0) perror_exit("write");
+  for (i = 0; i < 2; i++) {
+    if (file[i].mapped) munmap(file[i].data, file[i].size);
+    else free(file[i].data);
+    file[i].data = 0;
+    file[i].mapped = 0;
   }
-  return fdopen(tmpfd, "r");
 }
 
-static int read_tok(FILE *fp, off_t *off, int tok)
+// Return next character of line at *pos in the -biw sense, or'ed with the
+// flags above. Call with tok 0 at start of line, then pass back what it
+// returned until that has empty set.
+static int read_tok(char **pos, char *end, int tok)
 {
   int t = 0, is_space;
 
   tok |= empty;
   while (!(tok & eol)) {
 
-    t = fgetc(fp);
-    if (off && t != EOF) *off += 1;
+    t = (*pos < end) ? *(unsigned char *)(*pos)++ : EOF;
     is_space = isspace(t) || (t == EOF);
     tok |= (t & (eof + eol)); //set tok eof+eol when t is eof
 
@@ -229,217 +152,334 @@ static int read_tok(FILE *fp, off_t *off, int tok)
   return tok;
 }
 
-int bcomp(const void *a, const void *b) 
+// Are line n of file[i] and line m of file[j] the same?
+static int line_eq(int i, int n, int j, int m)
 {
-  struct v_vector *l = (struct v_vector*)a,
-                  *r = (struct v_vector*)b;
-  int ret = l->hash - r->hash;
+  char *p0 = file[i].data+TT.offset[i][n-1],
+       *p1 = file[j].data+TT.offset[j][m-1],
+       *e0 = file[i].data+file[i].size, *e1 = file[j].data+file[j].size;
+  int tok0 = 0, tok1 = 0;
 
-  if (!ret) {
-    if ((r -1)->last) return 0;
-    else return -1;
+  if (!(toys.optflags & (FLAG_b|FLAG_i|FLAG_w))) {
+    e0 = file[i].data+MIN(TT.offset[i][n], file[i].size);
+    e1 = file[j].data+MIN(TT.offset[j][m], file[j].size);
+
+    return e0-p0 == e1-p1 && !memcmp(p0, p1, e0-p0);
   }
-  return ret;
-}
-/*  file[0] corresponds file 1 and file[1] correspond file 2.
- * 1. calc hashes for both the files and store them in vector(v[0], v[1])
- * 2. sort file[1] with hash as primary and serial as sec. key
- * 3. Form the equivalance class of file[1] stored in e vector. It lists all the equivalence
- *    classes of lines in file[1], with e.last = true on the last element of each class.
- *    The elements are ordered by serial within classes.
- * 4. Form the p vector stored in  p_vector. p_vector[i], if non-zero, now points in e vector
- *    to the begining of the equiv class of lines in file[1] equivalent to line
- *    i in file[0].
- * 5. Form the k-candidates as discribed in do_merge.
- * 6. Create a vector J[i] = j, such that i'th line in file[0] is j'th line of
- *    file[1], i.e J comprises LCS
- */
-static int * create_j_vector()
-{
-  int tok, i, j, size = 100, k;
-  off_t off;
-  long hash;
-  int *p_vector, *J;
-  struct v_vector *v[2], *e;
-  struct candidate **kcand, *pr;
 
-  for (i = 0; i < 2; i++) {
-    tok = off = 0;
-    hash = 5831;
-    v[i] = xzalloc(size * sizeof(struct v_vector));
-    TT.offset[i] = xzalloc(size * sizeof(int));
-    file[i].len = 0;
-    fseek(file[i].fp, 0, SEEK_SET);
-
-    while (1) {
-      tok  = read_tok(file[i].fp, &off, tok);
-      if (!(tok & empty)) {
-        hash = ((hash << 5) + hash) + (tok & 0xff);
-        continue;
-      }
+  do {
+    tok0 = read_tok(&p0, e0, tok0);
+    tok1 = read_tok(&p1, e1, tok1);
+    if (((tok0 ^ tok1) & empty) || ((tok0 & 0xff) != (tok1 & 0xff))) return 0;
+  } while (!(tok0 & tok1 & empty));
 
-      if (size == ++file[i].len) {
-        size = size * 11 / 10;
-        v[i] = xrealloc(v[i], size*sizeof(struct v_vector));
-        TT.offset[i] = xrealloc(TT.offset[i], size*sizeof(int));
-      }
+  return 1;
+}
 
-      v[i][file[i].len].hash = hash & INT_MAX;
-      TT.offset[i][file[i].len] = off;
-      if ((tok & eof)) {
-        TT.offset[i][file[i].len] = ++off;
+// Split file[i] into lines: TT.offset[i][n] is the offset just past line n
+// (one more than the file length if the last line has no newline), and
+// returns a hash of each line.
+static unsigned *hash_lines(int i)
+{
+  char *pos = file[i].data, *end = pos+file[i].size, *s;
+  unsigned *hash = 0, h;
+  long size = 0, n = 0;
+  int tok;
+
+  for (;;) {
+    if (!(n&1023)) {
+      hash = xrealloc(hash, (n+1025)*sizeof(*hash));
+      TT.offset[i] = xrealloc(TT.offset[i], (n+1025)*sizeof(long));
+    }
+    TT.offset[i][n] = pos-file[i].data;
+    if (pos == end) break;
+    h = 5831;
+
+    // Fast path when we don't have to normalize anything
+    if (!(toys.optflags & (FLAG_b|FLAG_i|FLAG_w))) {
+      if (!(s = memchr(pos, '\n', end-pos))) s = end-1;
+      while (pos <= s) h = ((h << 5) + h) + *(unsigned char *)pos++;
+      if (s == end-1 && *s != '\n') size++;
+    } else for (tok = 0;;) {
+      tok = read_tok(&pos, end, tok);
+      if (tok & empty) {
+        if (tok & eof) size++;
         break;
       }
-      hash = 5831;  //next line
-      tok = 0;
+      h = ((h << 5) + h) + (tok & 0xff);
     }
-    if (TT.offset[i][file[i].len] - TT.offset[i][file[i].len - 1] == 1)
-      file[i].len--;
+    hash[++n] = h;
   }
+  TT.offset[i][n] += size;
+  file[i].len = n;
 
-  for (i = 0; i <= file[1].len; i++) v[1][i].serial = i;
-  qsort(v[1] + 1, file[1].len, sizeof(struct v_vector), comp);
+  return hash;
+}
 
-  e = v[1];
-  e[0].serial = 0;
-  e[0].last = 1;
-  for ( i = 1; i <= file[1].len; i++) {
-    if ((i == file[1].len) || (v[1][i].hash != v[1][i+1].hash)) e[i].last = 1;
-    else e[i].last = 0;
-  }
+// Find a point to split x[xoff..xlim) and y[yoff..ylim) where an optimal
+// edit script passes through, by running Myers' O(ND) search forward from
+// the start and backward from the end until the two meet. fd and bd are
+// indexed by diagonal (x-y). Unless -d, give up after "too_expensive"
+// rounds and take the furthest point reached instead.
+static void diag(int *x, int *y, long xoff, long xlim, long yoff, long ylim,
+  long *fd, long *bd, long *xmid, long *ymid, long too_expensive)
+{
+  long dmin = xoff-ylim, dmax = xlim-yoff, fmid = xoff-yoff, bmid = xlim-ylim,
+       fmin = fmid, fmax = fmid, bmin = bmid, bmax = bmid, c, d, xx, yy, lo, hi;
+  int odd = (fmid-bmid)&1;
+
+  fd[fmid] = xoff;
+  bd[bmid] = xlim;
+  for (c = 1;; c++) {
+    // Extend forward paths one more edit
+    if (fmin > dmin) fd[--fmin-1] = -1;
+    else fmin++;
+    if (fmax < dmax) fd[++fmax+1] = -1;
+    else fmax--;
+    for (d = fmax; d >= fmin; d -= 2) {
+      lo = fd[d-1];
+      hi = fd[d+1];
+      xx = (lo < hi) ? hi : lo+1;
+      for (yy = xx-d; xx < xlim && yy < ylim && x[xx] == y[yy]; xx++, yy++);
+      fd[d] = xx;
+      if (odd && bmin <= d && d <= bmax && bd[d] <= xx) {
+        *xmid = xx;
+        *ymid = yy;
 
-  p_vector = xzalloc((file[0].len + 2) * sizeof(int));
-  for (i = 1; i <= file[0].len; i++) {
-    void *r = bsearch(&v[0][i], (e + 1), file[1].len, sizeof(e[0]), bcomp);
-    if (r) p_vector[i] = (struct v_vector*)r - e;
-  }
+        return;
+      }
+    }
 
-  for (i = 1; i <= file[0].len; i++)
-    e[i].p = p_vector[i];
-  free(p_vector);
+    // Extend backward paths one more edit
+    if (bmin > dmin) bd[--bmin-1] = LONG_MAX;
+    else bmin++;
+    if (bmax < dmax) bd[++bmax+1] = LONG_MAX;
+    else bmax--;
+    for (d = bmax; d >= bmin; d -= 2) {
+      lo = bd[d-1];
+      hi = bd[d+1];
+      xx = (lo < hi) ? lo : hi-1;
+      for (yy = xx-d; xoff < xx && yoff < yy && x[xx-1] == y[yy-1]; xx--, yy--);
+      bd[d] = xx;
+      if (!odd && fmin <= d && d <= fmax && xx <= fd[d]) {
+        *xmid = xx;
+        *ymid = yy;
 
-  size = 100;
-  kcand = xzalloc(size * sizeof(struct candidate*));
+        return;
+      }
+    }
 
-  kcand[0] = new_candidate(0 , 0, NULL);
-  kcand[1] = new_candidate(file[0].len+1, file[1].len+1, NULL); //the fence
+    if (c >= too_expensive && !(toys.optflags & FLAG_d)) {
+      long fxy = -1, fx = 0, bxy = LONG_MAX, bx = 0;
 
-  k = 0;  //last successfully filled k candidate.
-  for (i = 1; i <= file[0].len; i++) {
+      for (d = fmax; d >= fmin; d -= 2) {
+        xx = MIN(fd[d], xlim);
+        yy = xx-d;
+        if (ylim < yy) xx = ylim+d, yy = ylim;
+        if (fxy < xx+yy) fxy = xx+yy, fx = xx;
+      }
+      for (d = bmax; d >= bmin; d -= 2) {
+        xx = MAX(xoff, bd[d]);
+        yy = xx-d;
+        if (yy < yoff) xx = yoff+d, yy = yoff;
+        if (xx+yy < bxy) bxy = xx+yy, bx = xx;
+      }
+      if ((xlim+ylim)-bxy < fxy-(xoff+yoff)) *xmid = fx, *ymid = fxy-fx;
+      else *xmid = bx, *ymid = bxy-bx;
 
-    if (!e[i].p) continue;
-    if ((size - 2) == k) {
-      size = size * 11 / 10;
-      kcand = xrealloc(kcand, (size * sizeof(struct candidate*)));
+      return;
     }
-    do_merge(kcand, &k, i, e, e[i].p);
   }
-  free(v[0]); //no need for v_vector now.
-  free(v[1]);
-
-  J = xzalloc((file[0].len + 2) * sizeof(int));
-
-  for (pr = kcand[k]; pr; pr = pr->prev)
-    J[pr->a] = pr->b;
-  J[file[0].len + 1] = file[1].len+1; //mark boundary
-
-  for (i = k + 1; i >= 0; i--) free_candidates(kcand[i]);
-  free(kcand);
+}
 
-  for (i = 1; i <= file[0].len; i++) { // jackpot?
-    if (!J[i]) continue;
+// Fill in J[] for the longest common subsequence of x[] and y[], which are
+// line equivalence classes. xmap[] and ymap[] translate back to line numbers.
+static void compareseq(int *x, int *y, long xoff, long xlim, long yoff,
+  long ylim, int *xmap, int *ymap, int *J, long *fd, long *bd, long te)
+{
+  long xmid, ymid;
+
+  for (;;) {
+    while (xoff < xlim && yoff < ylim && x[xoff] == y[yoff])
+      J[xmap[xoff++]] = ymap[yoff++];
+    while (xoff < xlim && yoff < ylim && x[xlim-1] == y[ylim-1])
+      J[xmap[--xlim]] = ymap[--ylim];
+    if (xoff == xlim || yoff == ylim) return;
+
+    diag(x, y, xoff, xlim, yoff, ylim, fd, bd, &xmid, &ymid, te);
+    compareseq(x, y, xoff, xmid, yoff, ymid, xmap, ymap, J, fd, bd, te);
+    xoff = xmid;
+    yoff = ymid;
+  }
+}
 
-    fseek(file[0].fp, TT.offset[0][i - 1], SEEK_SET);
-    fseek(file[1].fp, TT.offset[1][J[i] - 1], SEEK_SET);
+/*  file[0] corresponds file 1 and file[1] correspond file 2.
+ * 1. Split both files into lines and hash them.
+ * 2. Number each distinct line (via a hash table, checking the actual
+ *    contents when hashes collide) so lines compare as ints from then on.
+ * 3. Match up common leading and trailing lines.
+ * 4. Throw out lines that don't appear in the other file at all: they
+ *    can't be part of the longest common subsequence.
+ * 5. Find the LCS of what's left with Myers' algorithm (compareseq).
+ * 6. Return a vector J[i] = j, such that i'th line in file[0] is j'th line of
+ *    file[1], i.e J comprises LCS
+ */
+static int *create_j_vector()
+{
+  unsigned *hash[2], mask;
+  int *cls[2], *count[2], *tab, *rep, *x, *y, *xmap, *ymap, *J, n, i, j, k;
+  long lo, hi[2], nx, ny, *fd, *bd, te, diags;
+
+  for (i = 0; i < 2; i++) hash[i] = hash_lines(i);
+
+  // Hash table of first line (in either file) of each equivalence class
+  for (mask = 1023; mask < 2*(file[0].len+file[1].len); mask = mask*2+1);
+  tab = xzalloc((mask+1)*sizeof(int));
+  rep = xmalloc((file[0].len+file[1].len+1)*sizeof(int));
+  for (k = i = 0; i < 2; i++) {
+    cls[i] = xmalloc((file[i].len+1)*sizeof(int));
+    for (n = 1; n <= file[i].len; n++) {
+      unsigned h = hash[i][n];
+
+      for (;; h++) {
+        if (!(j = tab[h&mask])) {
+          tab[h&mask] = j = ++k;
+          rep[j] = i ? -n : n;
+          break;
+        }
+        if (hash[rep[j]<0][abs(rep[j])] == hash[i][n]
+          && line_eq(rep[j]<0, abs(rep[j]), i, n)) break;
+      }
+      cls[i][n] = j;
+    }
+  }
+  free(tab);
+  free(rep);
+  free(hash[0]);
+  free(hash[1]);
 
-    for (j = J[i]; i <= file[0].len && J[i] == j; i++, j++) {
-      int tok0 = 0, tok1 = 0;
+  J = xzalloc((file[0].len + 2) * sizeof(int));
+  J[file[0].len + 1] = file[1].len+1; //mark boundary
 
-      do {
-        tok0 = read_tok(file[0].fp, NULL, tok0);
-        tok1 = read_tok(file[1].fp, NULL, tok1);
-        if (((tok0 ^ tok1) & empty) || ((tok0 & 0xff) != (tok1 & 0xff)))
-          J[i] = 0;
-      } while (!(tok0 & tok1 & empty));
-    }
+  // Common prefix and suffix
+  for (lo = 1; lo <= file[0].len && lo <= file[1].len
+    && cls[0][lo] == cls[1][lo]; lo++) J[lo] = lo;
+  for (hi[0] = file[0].len, hi[1] = file[1].len; hi[0] >= lo && hi[1] >= lo
+    && cls[0][hi[0]] == cls[1][hi[1]]; hi[0]--, hi[1]--) J[hi[0]] = hi[1];
+
+  // Count how often each class occurs in the other file's middle, and keep
+  // only lines that have a chance of matching.
+  count[0] = xzalloc((k+1)*sizeof(int));
+  count[1] = xzalloc((k+1)*sizeof(int));
+  for (i = 0; i < 2; i++) for (n = lo; n <= hi[i]; n++) count[i][cls[i][n]]++;
+  x = xmalloc((hi[0]-lo+2)*sizeof(int));
+  xmap = xmalloc((hi[0]-lo+2)*sizeof(int));
+  y = xmalloc((hi[1]-lo+2)*sizeof(int));
+  ymap = xmalloc((hi[1]-lo+2)*sizeof(int));
+  for (nx = 0, n = lo; n <= hi[0]; n++) if (count[1][cls[0][n]]) {
+    xmap[nx] = n;
+    x[nx++] = cls[0][n];
+  }
+  for (ny = 0, n = lo; n <= hi[1]; n++) if (count[0][cls[1][n]]) {
+    ymap[ny] = n;
+    y[ny++] = cls[1][n];
   }
+  free(count[0]);
+  free(count[1]);
+  free(cls[0]);
+  free(cls[1]);
+
+  // Roughly sqrt of the number of diagonals, but at least 4096
+  for (te = 1, diags = nx+ny+3; diags; diags >>= 2) te <<= 1;
+  te = MAX(4096, te);
+  fd = xmalloc(2*(nx+ny+3)*sizeof(long));
+  bd = fd+nx+ny+3;
+  compareseq(x, y, 0, nx, 0, ny, xmap, ymap, J, fd+ny+1, bd+ny+1, te);
+  free(fd);
+  free(x);
+  free(y);
+  free(xmap);
+  free(ymap);
+
   return J;
 }
 
 static int *diff(char **files)
 {
-  size_t i ,j;
-  int s, t;
-  char *bufi, *bufj;
+  struct stat st[2];
+  int i, fd[2], fast = !(toys.optflags & (FLAG_b|FLAG_B|FLAG_i|FLAG_w));
 
   TT.is_binary = 0; //loop calls to diff
   TT.status = SAME;
 
   for (i = 0; i < 2; i++) {
-    if (IS_STDIN(files[i])) file[i].fp = read_stdin();
-    else file[i].fp = fopen(files[i], "r");
-
-    if (!file[i].fp){
+    fd[i] = IS_STDIN(files[i]) ? 0 : open(files[i], O_RDONLY);
+    if (fd[i] == -1 || fstat(fd[i], st+i)) {
       perror_msg("%s",files[i]);
+      if (i && fd[0]) close(fd[0]);
       TT.status = 2;
       return NULL; //return SAME
     }
   }
 
-  s = sizeof(toybuf)/2;
-  bufi = toybuf;
-  bufj = (toybuf + s);
+  // Answer from the metadata when that's enough: same file, or -q with
+  // different sizes (-biwB could make different bytes count as the same).
+  if (fast && S_ISREG(st[0].st_mode) && S_ISREG(st[1].st_mode)
+    && ((st[0].st_dev == st[1].st_dev && st[0].st_ino == st[1].st_ino)
+      || ((toys.optflags & FLAG_q) && st[0].st_size != st[1].st_size)))
+  {
+    if (st[0].st_size != st[1].st_size) TT.status = DIFFER;
+    for (i = 0; i < 2; i++) if (fd[i]) close(fd[i]);
 
-  fseek(file[0].fp, 0, SEEK_SET);
-  fseek(file[1].fp, 0, SEEK_SET);
-
-  if (toys.optflags & FLAG_a) return create_j_vector();
-
-  while (1) {
-    i = fread(bufi, 1, s, file[0].fp);
-    j = fread(bufj, 1, s, file[1].fp);
+    return NULL;
+  }
 
-    if (i != j) TT.status = DIFFER;
+  for (i = 0; i < 2; i++) {
+    if (!load_file(i, fd[i], st+i)) {
+      perror_msg("%s",files[i]);
+      if (!i && fd[1]) close(fd[1]);
+      TT.status = 2;
+      return NULL;
+    }
+  }
 
-    for (t = 0; t < i && !TT.is_binary; t++)
-      if (!bufi[t]) TT.is_binary = 1;
-    for (t = 0; t < j && !TT.is_binary; t++)
-      if (!bufj[t]) TT.is_binary = 1;
+  if (toys.optflags & FLAG_a) return create_j_vector();
 
-    i = MIN(i, j);
-    for (t = 0; t < i; t++)
-      if (bufi[t] != bufj[t]) TT.status = DIFFER;
+  for (i = 0; i < 2; i++)
+    if (memchr(file[i].data, 0, file[i].size)) TT.is_binary = 1;
+  if (file[0].size != file[1].size
+    || memcmp(file[0].data, file[1].data, file[0].size)) TT.status = DIFFER;
 
-    if (!i || !j) break;
-  }
+  // With -q and nothing to make different bytes match, that's the answer
   if (TT.is_binary || (TT.status == SAME)) return NULL;
+  if (fast && (toys.optflags & FLAG_q)) return NULL;
   return create_j_vector();
 }
 
-static void print_diff(int a, int b, char c, int *off_set, FILE *fp)
+static void print_diff(int a, int b, char c, int i)
 {
-  int i, j, cc, cl;
-  char *reset = NULL;
+  int n, cl;
+  char *reset = NULL, *s, *e, *end = file[i].data+file[i].size;
 
   if (c != ' ' && (toys.optflags & FLAG_color)) {
     printf("\033[%dm", c == '+' ? 32 : 31);
     reset = "\033[0m";
   }
 
-  for (i = a; i <= b; i++) {
-    fseek(fp, off_set[i - 1], SEEK_SET);
+  for (n = a; n <= b; n++) {
     putchar(c);
     if (toys.optflags & FLAG_T) putchar('\t');
-    for (j = 0, cl = 0; j <  (off_set[i] - off_set[i - 1]); j++) {
-      cc = fgetc(fp);
-      if (cc == EOF) {
+    s = file[i].data+TT.offset[i][n-1];
+    e = file[i].data+TT.offset[i][n];
+    for (cl = 0; s < e; s++) {
+      if (s == end) {
         printf("%s\n\\ No newline at end of file\n", reset ? reset : "");
         return;
       }
-      if ((cc == '\t') && (toys.optflags & FLAG_t))
+      if ((*s == '\t') && (toys.optflags & FLAG_t))
         do putchar(' '); while (++cl & 7);
       else {
-        putchar(cc); //xputc has calls to fflush, it hurts performance badly.
+        putchar(*s); //xputc has calls to fflush, it hurts performance badly.
         cl++;
       }
     }
@@ -639,12 +679,12 @@ calc_ct:
       putchar('\n');
 
       for (t = ptr1; t <= ptr2; t++) {
-        if (t== ptr1) print_diff(t->suff, t->a-1, ' ', TT.offset[0], file[0].fp);
-        print_diff(t->a, t->b, '-', TT.offset[0], file[0].fp);
-        print_diff(t->c, t->d, '+', TT.offset[1], file[1].fp);
+        if (t== ptr1) print_diff(t->suff, t->a-1, ' ', 0);
+        print_diff(t->a, t->b, '-', 0);
+        print_diff(t->c, t->d, '+', 1);
         if (t == ptr2)
-          print_diff(t->b+1, (t)->prev, ' ', TT.offset[0], file[0].fp);
-        else print_diff(t->b+1, (t+1)->a-1, ' ', TT.offset[0], file[0].fp);
+          print_diff(t->b+1, (t)->prev, ' ', 0);
+        else print_diff(t->b+1, (t+1)->a-1, ' ', 0);
       }
       ptr2++;
       ptr1 = ptr2;
@@ -717,8 +757,7 @@ static void create_empty_entry(int l , int r, int j)
   } else {
     do_diff(f);
     show_status(path);
-    if (file[0].fp) fclose(file[0].fp);
-    if (file[1].fp) fclose(file[1].fp);
+    unload_files();
   }
 
   if ((toys.optflags & FLAG_N) && j) {
@@ -850,8 +889,7 @@ void diff_main(void)
     }
     do_diff(files);
     show_status(files);
-    if (file[0].fp) fclose(file[0].fp);
-    if (file[1].fp) fclose(file[1].fp);
+    unload_files();
   }
   toys.exitval = TT.status; //exit status will be the status
 }
@@ -26,6 +26,7 @@ GLOBALS(
 
   struct stat *sought_files;
   struct double_list *all_sockets, *files;
+  struct num_hash sockets;
   int last_shown_pid, shown_header;
 )
 
@@ -130,6 +131,7 @@ static struct file_info *add_socket(ino_t inode, const char *type)
   struct file_info *fi = xzalloc(sizeof(struct file_info));
 
   dlist_add_nomalloc(&TT.all_sockets, (struct double_list *)fi);
+  add_num_hash(&TT.sockets, inode, &fi, sizeof(fi));
   fi->st_ino = inode;
   strcpy(fi->type, type);
   return fi;
@@ -217,6 +219,9 @@ static void scan_ip(char *line, int af, char type)
 static int find_socket(struct file_info *fi, long inode)
 {
   static int cached;
+  struct num_cache *nc;
+  struct file_info *s;
+
   if (!cached) {
     scan_proc_net_file("/proc/net/tcp", 4, 't', scan_ip);
     scan_proc_net_file("/proc/net/tcp6", 6, 't', scan_ip);
@@ -228,20 +233,13 @@ static int find_socket(struct file_info *fi, long inode)
     scan_proc_net_file("/proc/net/netlink", 0, 0, scan_netlink);
     cached = 1;
   }
-  void* list = TT.all_sockets;
+  if (!(nc = get_num_hash(&TT.sockets, inode))) return 0;
 
-  while (list) {
-    struct file_info *s = (struct file_info*) llist_pop(&list);
+  s = *(struct file_info **)nc->data;
+  fi->name = s->name ? strdup(s->name) : NULL;
+  strcpy(fi->type, s->type);
 
-    if (s->st_ino == inode) {
-      fi->name = s->name ? strdup(s->name) : NULL;
-      strcpy(fi->type, s->type);
-      return 1;
-    }
-    if (list == TT.all_sockets) break;
-  }
-
-  return 0;
+  return 1;
 }
 
 static void fill_stat(struct file_info *fi, const char *path)
@@ -448,5 +446,6 @@ void lsof_main(void)
   if (CFG_TOYBOX_FREE) {
     llist_traverse(TT.files, free_info);
     llist_traverse(TT.all_sockets, free_info);
+    free_num_hash(&TT.sockets);
   }
 }
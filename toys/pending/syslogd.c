@@ -43,7 +43,8 @@ struct unsocks {
   int sd;
 };
 
-// Log file entry to log into.
+// Log file entry to log into. Regular files buffer output in buf, and
+// track their size for rotation in size.
 struct logfile {
   struct logfile *next;
   char *filename;
@@ -51,8 +52,13 @@ struct logfile {
   uint8_t level[LOG_NFACILITIES];
   int logfd;
   struct sockaddr_in saddr;
+  char *buf;
+  int len;
+  long long size;
 };
 
+#define LOG_BUF 16384
+
 GLOBALS(
   char *socket;
   char *config_file;
@@ -67,6 +73,7 @@ GLOBALS(
   struct unsocks *lsocks;  // list of listen sockets
   struct logfile *lfiles;  // list of write logfiles
   int sigfd[2];
+  char *hostname;
 )
 
 // Lookup numerical code from name
@@ -266,7 +273,17 @@ static void open_logfiles(void)
 
       tfd->logfd = xsocket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
       free(tmpfile);
-    } else tfd->logfd = open(tfd->filename, O_CREAT | O_WRONLY | O_APPEND, 0666);
+    } else {
+      struct stat st;
+
+      tfd->logfd = open(tfd->filename, O_CREAT | O_WRONLY | O_APPEND, 0666);
+
+      // Devices such as /dev/kmsg want one message per write
+      if (tfd->logfd >= 0 && !fstat(tfd->logfd, &st) && S_ISREG(st.st_mode)) {
+        tfd->buf = xmalloc(LOG_BUF);
+        tfd->size = st.st_size;
+      }
+    }
     if (tfd->logfd < 0) {
       tfd->filename = "/dev/console";
       tfd->logfd = open(tfd->filename, O_APPEND);
@@ -274,16 +291,28 @@ static void open_logfiles(void)
   }
 }
 
+// Write out what's buffered for a log file
+static void flush_log(struct logfile *tf)
+{
+  if (tf->len && tf->logfd > 0 && writeall(tf->logfd, tf->buf, tf->len) < 0)
+    perror_msg("write failed file : %s ", tf->filename);
+  tf->len = 0;
+}
+
+static void flush_logs(void)
+{
+  struct logfile *tf;
+
+  for (tf = TT.lfiles; tf; tf = tf->next) flush_log(tf);
+}
+
 //write to file with rotation
 static int write_rotate(struct logfile *tf, int len)
 {
-  int size, isreg;
-  struct stat statf;
-  isreg = (!fstat(tf->logfd, &statf) && S_ISREG(statf.st_mode));
-  size = statf.st_size;
-
   if ((toys.optflags & FLAG_s) || (toys.optflags & FLAG_b)) {
-    if (TT.rot_size && isreg && (size + len) > (TT.rot_size*1024)) {
+    if (TT.rot_size && tf->buf && (tf->size + len) > (TT.rot_size*1024)) {
+      flush_log(tf);
+      tf->size = 0;
       if (TT.rot_count) { /* always 0..99 */
         int i = strlen(tf->filename) + 3 + 1;
         char old_file[i];
@@ -307,7 +336,14 @@ static int write_rotate(struct logfile *tf, int len)
       ftruncate(tf->logfd, 0);
     }
   }
-  return write(tf->logfd, toybuf, len);
+  if (!tf->buf) return write(tf->logfd, toybuf, len);
+
+  if (tf->len + len > LOG_BUF) flush_log(tf);
+  memcpy(tf->buf + tf->len, toybuf, len);
+  tf->len += len;
+  tf->size += len;
+
+  return len;
 }
 
 //Parse messege and write to file.
@@ -315,7 +351,6 @@ static void logmsg(char *msg, int len)
 {
   time_t now;
   char *p, *ts, *lvlstr, *facstr;
-  struct utsname uts;
   int pri = 0;
   struct logfile *tf = TT.lfiles;
 
@@ -349,10 +384,9 @@ static void logmsg(char *msg, int len)
     facstr = dec(pri & LOG_FACMASK, facilitynames, facbuf);
     lvlstr = dec(LOG_PRI(pri), prioritynames, pribuf);
 
-    p = "local";
-    if (!uname(&uts)) p = uts.nodename;
     if (toys.optflags & FLAG_S) len = sprintf(toybuf, "%s %s\n", ts, msg);
-    else len = sprintf(toybuf, "%s %s %s.%s %s\n", ts, p, facstr, lvlstr, msg);
+    else len = sprintf(toybuf, "%s %s %s.%s %s\n", ts, TT.hostname, facstr,
+      lvlstr, msg);
   }
   if (lvl >= TT.log_prio) return;
 
@@ -389,7 +423,9 @@ static void cleanup(void)
   while (TT.lfiles) {
     struct logfile *fnode = TT.lfiles;
 
+    flush_log(fnode);
     free(fnode->filename);
+    free(fnode->buf);
     if (fnode->logfd >= 0) close(fnode->logfd);
     TT.lfiles = fnode->next;
     free(fnode);
@@ -407,6 +443,7 @@ void syslogd_main(void)
   struct unsocks *tsd;
   int nfds, retval, last_len=0;
   struct timeval tv;
+  struct utsname uts;
   fd_set rfds;        // fds for reading
   char *temp, *buffer = (toybuf +2048), *last_buf = (toybuf + 3072); //these two buffs are of 1K each
 
@@ -472,6 +509,8 @@ init_jumpin:
 
   if (parse_config_file() == -1) goto clean_and_exit;
   open_logfiles();
+  free(TT.hostname);
+  TT.hostname = xstrdup(uname(&uts) ? "local" : uts.nodename);
   if (!(toys.optflags & FLAG_n)) {
     daemon(0, 0);
     //don't daemonize again if SIGHUP received.
@@ -481,6 +520,9 @@ init_jumpin:
 
   logmsg("<46>Toybox: syslogd started", 27); //27 : the length of message
   for (;;) {
+    // Everything logged so far goes out before we wait for more
+    flush_logs();
+
     // Add opened socks to rfds for select()
     FD_ZERO(&rfds);
     for (tsd = TT.lsocks; tsd; tsd = tsd->next) FD_SET(tsd->sd, &rfds);
@@ -505,6 +547,7 @@ init_jumpin:
         case SIGINT:     /* FALLTHROUGH */
         case SIGQUIT:
           logmsg("<46>syslogd exiting", 19);
+          flush_logs();
           if (CFG_TOYBOX_FREE ) cleanup();
           signal(sig, SIG_DFL);
           sigset_t ss;
@@ -521,20 +564,24 @@ init_jumpin:
         default: break;
       }
     } else { /* Some activity on listen sockets. */
+      // Take a batch of queued messages from each ready socket, so a burst
+      // costs one select() and one write() per log file per batch.
       for (tsd = TT.lsocks; tsd; tsd = tsd->next) {
-        int sd = tsd->sd;
-        if (FD_ISSET(sd, &rfds)) {
-          int len = read(sd, buffer, 1023); //buffer is of 1K, hence readingonly 1023 bytes, 1 for NUL
-          if (len > 0) {
-            buffer[len] = '\0';
-            if((toys.optflags & FLAG_D) && (len == last_len))
-              if (!memcmp(last_buf, buffer, len)) break;
-
-            memcpy(last_buf, buffer, len);
-            last_len = len;
-            logmsg(buffer, len);
-          }
-          break;
+        int sd = tsd->sd, i;
+
+        if (!FD_ISSET(sd, &rfds)) continue;
+        for (i = 0; i < 256; i++) {
+          //buffer is of 1K, hence readingonly 1023 bytes, 1 for NUL
+          int len = recv(sd, buffer, 1023, MSG_DONTWAIT);
+
+          if (len <= 0) break;
+          buffer[len] = '\0';
+          if ((toys.optflags & FLAG_D) && (len == last_len))
+            if (!memcmp(last_buf, buffer, len)) continue;
+
+          memcpy(last_buf, buffer, len);
+          last_len = len;
+          logmsg(buffer, len);
         }
       }
     }
@@ -48,27 +48,27 @@ GLOBALS(
   int maxc;
   int count_all;
   int udp;
+  char *server;
+  struct sockaddr *haddr;
 )
 
-struct list_pid {
-  struct list_pid *next;
-  char *ip;  
-  int pid;
+// Connection count per peer address, found by hashing the binary address.
+struct peer {
+  struct peer *next;
+  char ip[16];
+  int len, count;
 };
 
-struct list {
-  struct list* next;
-  char *d;
-  int count;
-};
-
-struct hashed {
-  struct list *head;
+// Each running child and the peer it's serving, hashed by pid.
+struct child {
+  struct child *next;
+  struct peer *peer;
+  pid_t pid;
 };
 
-#define HASH_NR 256
-struct hashed h[HASH_NR];
-struct list_pid *pids = NULL;
+#define HASH_NR 1024
+static struct peer *peers[HASH_NR];
+static struct child *children[HASH_NR];
 
 // convert IP address to string.
 static char *sock_to_address(struct sockaddr *sock, int flags)
@@ -86,103 +86,69 @@ static char *sock_to_address(struct sockaddr *sock, int flags)
   error_exit("getnameinfo: %s", gai_strerror(status));
 }
 
-// Insert pid, ip and fd in the list.
-static void insert(struct list_pid **l, int pid, char *addr)
+// Numeric "ip:port" without going through getnameinfo()
+static char *sock_to_numeric(struct sockaddr *sa)
 {
-  struct list_pid *newnode = xmalloc(sizeof(struct list_pid));
-  newnode->pid = pid;
-  newnode->ip = addr;
-  newnode->next = NULL;
-  if (!*l) *l = newnode;
-  else {
-    newnode->next = (*l);
-   *l = newnode;
-  }
-}
+  unsigned short port = (sa->sa_family == AF_INET)
+    ? ((struct sockaddr_in *)sa)->sin_port
+    : ((struct sockaddr_in6 *)sa)->sin6_port;
 
-// Hashing of IP address.
-static int haship( char *addr)
-{
-  uint32_t ip[8] = {0,};
-  int count = 0, i = 0;
-
-  if (!addr) error_exit("NULL ip");
-  while (i < strlen(addr)) {
-    while (addr[i] && (addr[i] != ':') && (addr[i] != '.')) {
-      ip[count] = ip[count]*10 + (addr[i]-'0');
-      i++;
-    }
-    if (i >= strlen(addr)) break;
-    count++;
-    i++;
-  }
-  return (ip[0]^ip[1]^ip[2]^ip[3]^ip[4]^ip[5]^ip[6]^ip[7])%HASH_NR;
+  return xmprintf("%s:%u", ntop(sa), SWAP_BE16(port));
 }
 
-// Remove a node from the list.
-static char *delete(struct list_pid **pids, int pid)
+// Find the hash chain link to the peer entry for this address, adding one
+// if asked to.
+static struct peer **find_peer(char *ip, unsigned len, int create)
 {
-  struct list_pid *prev, *free_node, *head = *pids; 
-  char *ip = NULL;
- 
-  if (!head) return NULL;
-  prev = free_node = NULL;
-  while (head) {
-    if (head->pid == pid) {
-      ip = head->ip;
-      free_node = head;
-      if (!prev) *pids = head->next;
-      else prev->next = head->next;
-      free(free_node);
-      return ip;
-    }
-    prev = head;
-    head = head->next;
+  struct peer **pp;
+  unsigned i, hash = 2166136261;
+
+  for (i = 0; i<len; i++) hash = (hash^(unsigned char)ip[i])*16777619;
+  for (pp = peers+hash%HASH_NR; *pp; pp = &(*pp)->next)
+    if ((*pp)->len == len && !memcmp((*pp)->ip, ip, len)) return pp;
+  if (create) {
+    *pp = xzalloc(sizeof(struct peer));
+    memcpy((*pp)->ip, ip, (*pp)->len = len);
   }
-  return NULL;
+
+  return pp;
 }
 
-// decrement the ref count fora connection, if count reches ZERO then remove the node
-static void remove_connection(char *ip)
+static struct peer **sock_to_peer(struct sockaddr *sa, int create)
 {
-  struct list *head, *prev = NULL, *free_node = NULL;
-  int hash = haship(ip);
-
-  head = h[hash].head;
-  while (head) {
-    if (!strcmp(ip, head->d)) {
-      head->count--;
-      free_node = head;
-      if (!head->count) {
-        if (!prev) h[hash].head = head->next;
-        else prev->next = head->next;
-        free(free_node);
-      }
-      break;
-    }
-    prev = head;
-    head = head->next;
-  }
-  free(ip);
+  if (sa->sa_family == AF_INET)
+    return find_peer((void *)&((struct sockaddr_in *)sa)->sin_addr, 4, create);
+  return find_peer((void *)&((struct sockaddr_in6 *)sa)->sin6_addr, 16, create);
 }
 
-// Handler function.
-static void handle_exit(int sig)
+// Collect exited children and release their connection slots.
+static void reap(void)
 {
+  struct child **cc, *c;
+  struct peer **pp, *p;
   int status;
-  pid_t pid_n = wait(&status);
+  pid_t pid;
 
-  if (pid_n <= 0) return;
-  char *ip = delete(&pids, pid_n);
-  if (!ip) return;
-  remove_connection(ip);
-  TT.count_all--;
-  if (toys.optflags & FLAG_v) {
-    if (WIFEXITED(status))
-      xprintf("%s: end %d exit %d\n",toys.which->name, pid_n, WEXITSTATUS(status));
-    else if (WIFSIGNALED(status))
-      xprintf("%s: end %d signaled %d\n",toys.which->name, pid_n, WTERMSIG(status));
-    if (TT.cn > 1) xprintf("%s: status %d/%d\n",toys.which->name, TT.count_all, TT.cn);
+  while (0<(pid = waitpid(-1, &status, WNOHANG))) {
+    for (cc = children+pid%HASH_NR; *cc; cc = &(*cc)->next)
+      if ((*cc)->pid == pid) break;
+    if (!(c = *cc)) continue;
+    *cc = c->next;
+    p = c->peer;
+    free(c);
+    if (!--p->count) {
+      pp = find_peer(p->ip, p->len, 0);
+      *pp = p->next;
+      free(p);
+    }
+    TT.count_all--;
+    if (toys.optflags & FLAG_v) {
+      if (WIFEXITED(status))
+        xprintf("%s: end %d exit %d\n",toys.which->name, pid, WEXITSTATUS(status));
+      else if (WIFSIGNALED(status))
+        xprintf("%s: end %d signaled %d\n",toys.which->name, pid, WTERMSIG(status));
+      if (TT.cn > 1) xprintf("%s: status %d/%ld\n",toys.which->name, TT.count_all, TT.cn);
+    }
   }
 }
 
@@ -261,26 +227,94 @@ static void handle_signal(int sig)
   _exit(sig + 128); //should not reach here
 } 
 
+// Start PROG for a connection on fd from the peer at sa, returning 0 if
+// it was turned away by -C instead.
+static int new_conn(int fd, struct sockaddr *sa)
+{
+  struct peer **pp = sock_to_peer(sa, 0);
+  struct child *c;
+  char *client, *serv = 0, *clie = 0;
+  pid_t pid;
+
+  if ((toys.optflags & FLAG_C) && *pp && (*pp)->count >= TT.maxc) {
+    if (TT.nmsg) write(fd, TT.nmsg, strlen(TT.nmsg)+1);
+    close(fd);
+
+    return 0;
+  }
+  TT.count_all++;
+  client = sock_to_numeric(sa);
+  if (!(toys.optflags & FLAG_E)) setenv("PROTOREMOTEADDR", client, 1);
+
+  // Name lookups can take a while, so those happen in a forked child.
+  // Otherwise vfork() and exec straight away.
+  if (toys.optflags & FLAG_h) pid = xfork();
+  else pid = XVFORK();
+  if (!pid) {
+    if (toys.optflags & FLAG_h) {
+      if (toys.optflags & FLAG_l) serv = TT.name;
+      else serv = sock_to_address(TT.haddr, 0);
+      clie = sock_to_address(sa, 0);
+      if (!(toys.optflags & FLAG_E)) {
+        setenv("PROTOLOCALHOST", serv, 1);
+        setenv("PROTOREMOTEHOST", clie, 1);
+      }
+      if (toys.optflags & FLAG_v) {
+        xprintf("%s: start %d %s-%s (%s-%s)\n", toys.which->name, getpid(),
+          TT.server, client, serv, clie);
+        if (TT.cn > 1)
+          xprintf("%s: status %d/%ld\n",toys.which->name, TT.count_all, TT.cn);
+      }
+    }
+    // No perror_exit() here, a vfork child mustn't run the parent's exit path
+    if (TT.udp && (connect(fd, sa, sizeof(struct sockaddr_in6)) < 0)) {
+      perror_msg("connect");
+      _exit(1);
+    }
+
+    close(0);
+    close(1);
+    dup2(fd, 0);
+    dup2(fd, 1);
+    if (fd > 1) close(fd);
+    xexec(toys.optargs+2); //skip IP PORT
+  }
+
+  if ((toys.optflags & (FLAG_v|FLAG_h)) == FLAG_v) {
+    xprintf("%s: start %d %s-%s\n", toys.which->name, pid, TT.server, client);
+    if (TT.cn > 1)
+      xprintf("%s: status %d/%ld\n",toys.which->name, TT.count_all, TT.cn);
+  }
+  free(client);
+
+  c = xmalloc(sizeof(struct child));
+  c->pid = pid;
+  c->peer = *(pp = sock_to_peer(sa, 1));
+  c->peer->count++;
+  c->next = children[pid%HASH_NR];
+  children[pid%HASH_NR] = c;
+  xclose(fd);
+
+  return 1;
+}
+
 void tcpsvd_main(void)
 {
   uid_t uid = 0;
   gid_t gid = 0;
-  pid_t pid;
-  char haddr[sizeof(struct sockaddr_in6)];
-  struct list *head, *newnode;
-  int hash, fd, newfd, j;
-  char *ptr = NULL, *addr, *server, buf[sizeof(struct sockaddr_in6)];
-  socklen_t len = sizeof(buf);
+  char haddr[sizeof(struct sockaddr_in6)], buf[sizeof(struct sockaddr_in6)];
+  struct pollfd pfd[2];
+  int fd, newfd, sig[2];
+  socklen_t len;
 
   TT.udp = (*toys.which->name == 'u');
   if (TT.udp) toys.optflags &= ~FLAG_C;
-  memset(buf, 0, len);
   if (toys.optflags & FLAG_C) {
-    if ((ptr = strchr(TT.nmsg, ':'))) {
-      *ptr = '\0';
-      ptr++;
-    }
+    char *ptr = strchr(TT.nmsg, ':');
+
+    if (ptr) *ptr++ = 0;
     TT.maxc = atolx_range(TT.nmsg, 1, INT_MAX);
+    TT.nmsg = ptr;
   }
   
   fd = create_bind_sock(toys.optargs[0], (struct sockaddr*)&haddr);
@@ -291,114 +325,72 @@ void tcpsvd_main(void)
   }
 
   if (!TT.udp && (listen(fd, TT.bn) < 0)) perror_exit("Listen failed");
-  server = sock_to_address((struct sockaddr*)&haddr, NI_NUMERICHOST|NI_NUMERICSERV);
+  TT.haddr = (void *)haddr;
+  TT.server = sock_to_address(TT.haddr, NI_NUMERICHOST|NI_NUMERICSERV);
   if (toys.optflags & FLAG_v) {
     if (toys.optflags & FLAG_u)
       xprintf("%s: listening on %s, starting, uid %u, gid %u\n"
-          ,toys.which->name, server, uid, gid);
+          ,toys.which->name, TT.server, uid, gid);
     else 
-      xprintf("%s: listening on %s, starting\n", toys.which->name, server);
+      xprintf("%s: listening on %s, starting\n", toys.which->name, TT.server);
+  }
+
+  // The parts of the environment that are the same for every connection
+  if (!(toys.optflags & FLAG_E)) {
+    setenv("PROTO", TT.udp ?"UDP" :"TCP", 1);
+    setenv("PROTOLOCALADDR", TT.server, 1);
+    if (!TT.udp) {
+      sprintf(toybuf, "%d", TT.maxc);
+      setenv("TCPCONCURRENCY", toybuf, 1); //Not valid for udp
+    }
   }
-  for (j = 0; j < HASH_NR; j++) h[j].head = NULL;
-  sigatexit(handle_signal);  
-  signal(SIGCHLD, handle_exit);
 
-  while (1) {
-    if (TT.count_all  < TT.cn) {
+  // SIGCHLD writes to a pipe that wakes up the poll loop, which reaps
+  // children outside of signal context.
+  xpipe(sig);
+  for (newfd = 0; newfd<2; newfd++) {
+    fcntl(sig[newfd], F_SETFL, O_NONBLOCK);
+    fcntl(sig[newfd], F_SETFD, FD_CLOEXEC);
+  }
+  toys.signalfd = sig[1];
+  sigatexit(handle_signal);  
+  xsignal(SIGCHLD, generic_signal);
+  pfd[1].fd = sig[0];
+  pfd[1].events = POLLIN;
+
+  fcntl(fd, F_SETFL, O_NONBLOCK);
+
+  for (;;) {
+    // Stop listening while at the -c limit
+    pfd[0].fd = fd;
+    pfd[0].events = (TT.count_all < TT.cn) ? POLLIN : 0;
+    xpoll(pfd, 2, -1);
+    while (0 < read(sig[0], toybuf, sizeof(toybuf)));
+    toys.signal = 0;
+    reap();
+
+    // Take everything that's queued, up to the -c limit
+    while (TT.count_all < TT.cn) {
+      len = sizeof(buf);
       if (TT.udp) {
-        if(recvfrom(fd, NULL, 0, MSG_PEEK, (struct sockaddr *)buf, &len) < 0)
-          perror_exit("recvfrom");
         newfd = fd;
-      } else {
-        newfd = accept(fd, (struct sockaddr *)buf, &len);
-        if (newfd < 0) perror_exit("Error on accept");
+        if (recvfrom(fd, NULL, 0, MSG_PEEK, (void *)buf, &len) < 0) newfd = -1;
+      } else newfd = accept(fd, (void *)buf, &len);
+      if (newfd < 0) {
+        if (errno == EINTR || errno == ECONNABORTED) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+        perror_exit(TT.udp ? "recvfrom" : "Error on accept");
       }
-    } else {
-      sigset_t ss;
-      sigemptyset(&ss);
-      sigsuspend(&ss);
-      continue;
-    }
-    TT.count_all++;
-    addr = sock_to_address((struct sockaddr*)buf, NI_NUMERICHOST);
-
-    hash = haship(addr);
-    if (toys.optflags & FLAG_C) {
-      for (head = h[hash].head; head; head = head->next)
-        if (!strcmp(head->d, addr)) break;
-
-      if (head && head->count >= TT.maxc) {
-        if (ptr) write(newfd, ptr, strlen(ptr)+1);
-        close(newfd);
-        TT.count_all--;
-        continue;
-      }
-    }
 
-    newnode = (struct list*)xzalloc(sizeof(struct list));
-    newnode->d = addr;
-    for (head = h[hash].head; head; head = head->next) {
-      if (!strcmp(addr, head->d)) {
-        head->count++;
-        free(newnode);
+      // The datagram socket goes to the child, so make a new one
+      if (TT.udp) {
+        fcntl(fd, F_SETFL, 0);
+        new_conn(fd, (void *)buf);
+        fd = create_bind_sock(toys.optargs[0], (void *)&haddr);
+        fcntl(fd, F_SETFL, O_NONBLOCK);
         break;
       }
+      new_conn(newfd, (void *)buf);
     }
-
-    if (!head) {
-      newnode->next = h[hash].head;
-      h[hash].head = newnode;
-      h[hash].head->count++;
-    }
-
-    if (!(pid = xfork())) {
-      char *serv = NULL, *clie = NULL;
-      char *client = sock_to_address((struct sockaddr*)buf, NI_NUMERICHOST | NI_NUMERICSERV);
-      if (toys.optflags & FLAG_h) { //lookup name
-        if (toys.optflags & FLAG_l) serv = xstrdup(TT.name);
-        else serv = sock_to_address((struct sockaddr*)&haddr, 0);
-        clie = sock_to_address((struct sockaddr*)buf, 0);
-      }
-
-      if (!(toys.optflags & FLAG_E)) {
-        setenv("PROTO", TT.udp ?"UDP" :"TCP", 1);
-        setenv("PROTOLOCALADDR", server, 1);
-        setenv("PROTOREMOTEADDR", client, 1);
-        if (toys.optflags & FLAG_h) {
-          setenv("PROTOLOCALHOST", serv, 1);
-          setenv("PROTOREMOTEHOST", clie, 1);
-        }
-        if (!TT.udp) {
-          char max_c[32];
-          sprintf(max_c, "%d", TT.maxc);
-          setenv("TCPCONCURRENCY", max_c, 1); //Not valid for udp
-        }
-      }
-      if (toys.optflags & FLAG_v) {
-        xprintf("%s: start %d %s-%s",toys.which->name, getpid(), server, client);
-        if (toys.optflags & FLAG_h) xprintf(" (%s-%s)", serv, clie);
-        xputc('\n');
-        if (TT.cn > 1) 
-          xprintf("%s: status %d/%d\n",toys.which->name, TT.count_all, TT.cn);
-      }
-      free(client);
-      if (toys.optflags & FLAG_h) {
-        free(serv);
-        free(clie);
-      }
-      if (TT.udp && (connect(newfd, (struct sockaddr *)buf, sizeof(buf)) < 0))
-          perror_exit("connect");
-
-      close(0);
-      close(1);
-      dup2(newfd, 0);
-      dup2(newfd, 1);
-      xexec(toys.optargs+2); //skip IP PORT
-    } else {
-      insert(&pids, pid, addr);
-      xclose(newfd); //close and reopen for next client.
-      if (TT.udp) fd = create_bind_sock(toys.optargs[0],
-          (struct sockaddr*)&haddr);
-    }
-  } //while(1)
+  }
 }
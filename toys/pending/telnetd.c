@@ -25,6 +25,8 @@ config TELNETD
 #define FOR_telnetd
 #include "toys.h"
 #include <utmp.h>
+#include <sys/epoll.h>
+#include <sys/uio.h>
 GLOBALS(
     char *login_path;
     char *issue_path;
@@ -32,8 +34,9 @@ GLOBALS(
     char *host_addr;
     long w_sec;
 
-    int gmax_fd;
+    int epfd, nfds;
     pid_t fork_pid;
+    struct term_session *sessions, **fds;
 )
 
 
@@ -50,19 +53,22 @@ GLOBALS(
 # define TELOPT_TTYPE 24  /* terminal type */
 # define TELOPT_NAWS  31  /* window size */
 
+// Power of 2, ring offsets are free running counters masked on use
 #define BUFSIZE 4*1024
+struct ring {
+  unsigned head, tail;  // data is tail..head
+  char buf[BUFSIZE];
+};
+
 struct term_session {
-  int new_fd, pty_fd;
-  pid_t child_pid;
-  int buff1_avail, buff2_avail;
-  int buff1_written, buff2_written;
-  int rem;  //unprocessed data from socket
-  char buff1[BUFSIZE], buff2[BUFSIZE];
   struct term_session *next;
+  int net_in, net_out, pty_fd, ev[3];
+  pid_t child_pid;
+  char iac[8];  // partial telnet command left over from last socket read
+  int iaclen, cr, sb;
+  struct ring to_net, to_pty;
 };
 
-struct term_session *session_list = NULL;
-
 static void get_sockaddr(char *host, void *buf)
 {
   in_port_t port_num = htons(TT.port);
@@ -149,7 +155,7 @@ static int listen_socket(void)
     perror_exit("bind");
   }
 
-  if (listen(s, 1) < 0) perror_exit("listen");
+  if (listen(s, SOMAXCONN) < 0) perror_exit("listen");
   return s;
 }
 
@@ -206,241 +212,311 @@ static int new_session(int sockfd)
   exit(EXIT_FAILURE);
 }
 
-static int handle_iacs(struct term_session *tm, int c, int fd)
+static unsigned ring_used(struct ring *r)
 {
-  char *curr ,*start,*end;
-  int i = 0;
+  return r->head - r->tail;
+}
 
-  curr = start = tm->buff2+tm->buff2_avail; 
-  end = tm->buff2 + c -1;
-  tm->rem = 0;
-  while (curr <= end) {
-    if (*curr != IAC){
+static unsigned ring_free(struct ring *r)
+{
+  return BUFSIZE - ring_used(r);
+}
 
-      if (*curr != '\r') {
-        toybuf[i++] = *curr++;
-        continue;
-      } else {
-        toybuf[i++] = *curr++;
-        curr++;
-        if (curr < end && (*curr == '\n' || *curr == '\0')) 
-          curr++;
-        continue;
-      }
-    }
+static void ring_put(struct ring *r, void *data, unsigned len)
+{
+  char *s = data;
+  unsigned off, n;
+
+  while (len) {
+    off = r->head & (BUFSIZE-1);
+    n = minof(len, BUFSIZE-off);
+    memcpy(r->buf+off, s, n);
+    r->head += n;
+    s += n;
+    len -= n;
+  }
+}
 
-    if ((curr + 1) > end) {
-      tm->rem = 1;
-      break; 
+// Write as much queued data as fd will take (both halves of a wrapped ring
+// in one writev). Returns -1 on error, 0 otherwise.
+static int ring_flush(struct ring *r, int fd)
+{
+  struct iovec iov[2];
+  unsigned off = r->tail & (BUFSIZE-1), len = ring_used(r);
+  ssize_t n;
+
+  if (!len) return 0;
+  iov[0].iov_base = r->buf+off;
+  iov[0].iov_len = minof(len, BUFSIZE-off);
+  iov[1].iov_base = r->buf;
+  iov[1].iov_len = len-iov[0].iov_len;
+  if ((n = writev(fd, iov, 1+!!iov[1].iov_len)) < 0)
+    return (errno == EAGAIN || errno == EINTR) ? 0 : -1;
+  r->tail += n;
+
+  return 0;
+}
+
+// Returns 0 if read would block, -1 on EOF or error, else bytes read
+static int read_nonblock(int fd, void *buf, int len)
+{
+  if (!len || (len = read(fd, buf, len)) > 0) return len ? len : -1;
+  return (len < 0 && (errno == EAGAIN || errno == EINTR)) ? 0 : -1;
+}
+
+// Act on telnet command at s (starting with IAC). Returns bytes consumed or
+// 0 if the command isn't all here yet.
+static int handle_iac(struct term_session *tm, unsigned char *s, int len)
+{
+  struct winsize ws;
+
+  if (len < 2) return 0;
+  if (s[1] == IAC) ring_put(&tm->to_pty, s, 1);
+  else if (s[1] >= WILL && s[1] <= DONT) return (len < 3) ? 0 : 3;
+  else if (s[1] == SB) {
+    // Eat everything up to IAC SE, grabbing window size on the way
+    if (len < 3 || (s[2] == TELOPT_NAWS && len < 7)) return 0;
+    tm->sb = 1;
+    if (s[2] == TELOPT_NAWS) {
+      ws.ws_col = (s[3] << 8) | s[4];
+      ws.ws_row = (s[5] << 8) | s[6];
+      ioctl(tm->pty_fd, TIOCSWINSZ, &ws);
+
+      return 7;
     }
-    if (*(curr+1) == IAC) { //IAC as data --> IAC IAC
-      toybuf[i++] = *(curr+1);
-      curr += 2; //IAC IAC --> 2 bytes
+  }
+
+  return 2;
+}
+
+// Strip telnet commands from socket data and queue the rest for the pty,
+// turning CR LF and CR NUL into CR. Only the bytes that need attention are
+// looked at, runs between them are found with memchr() and copied whole.
+static int net_to_pty(struct term_session *tm)
+{
+  unsigned char *s = (void *)toybuf, *e, *p, *iac, *cr;
+  int len = minof(ring_free(&tm->to_pty), sizeof(toybuf))-tm->iaclen;
+
+  // Only a hangup or error gets us here without room, so give up
+  if (len < 1) return -1;
+  memcpy(s, tm->iac, tm->iaclen);
+  if ((len = read_nonblock(tm->net_in, s+tm->iaclen, len)) < 1) return len;
+  e = s+tm->iaclen+len;
+  tm->iaclen = 0;
+  iac = memchr(s, IAC, e-s);
+  cr = memchr(s, '\r', e-s);
+
+  while (s < e) {
+    if (tm->sb) {
+      if (!(p = memchr(s, IAC, e-s))) break;
+      if (p+1 == e) {
+        s = p;
+        goto save;
+      }
+      if (p[1] == SE) tm->sb = 0;
+      s = p+2;
       continue;
     }
-    if (*(curr + 1) == NOP || *(curr + 1) == SE) {
-      curr += 2;
+    if (tm->cr) {
+      tm->cr = 0;
+      if (!*s || *s == '\n') s++;
       continue;
     }
+    if (iac && iac < s) iac = memchr(s, IAC, e-s);
+    if (cr && cr < s) cr = memchr(s, '\r', e-s);
+    p = iac ? iac : e;
+    if (cr && cr < p) p = cr;
+    ring_put(&tm->to_pty, s, p-s);
+    if ((s = p) == e) break;
+    if (*s == '\r') {
+      ring_put(&tm->to_pty, s++, 1);
+      tm->cr = 1;
+    } else if (!(len = handle_iac(tm, s, e-s))) goto save;
+    else s += len;
+  }
 
-    if (*(curr + 1) == SB ) {
-      if (*(curr+2) == TELOPT_NAWS) {
-        struct winsize ws;
-        if ((curr+8) >= end) {  //ensure we have data to process.
-          tm->rem = end - curr; 
-          break;  
-        }
-        ws.ws_col = (curr[3] << 8) | curr[4];
-        ws.ws_row = (curr[5] << 8) | curr[6];
-        ioctl(fd, TIOCSWINSZ, (char *)&ws);
-        curr += 9;
-        continue;
-      } else { //eat non-supported sub neg. options.
-        curr++, tm->rem++;
-        while (*curr != IAC && curr <= end) {
-          curr++;
-          tm->rem++;
-        } 
-        if (*curr == IAC) {
-          tm->rem = 0;
-          continue;
-        } else break;
-      }
-    }
-    curr += 3; //skip non-supported 3 bytes.
+  return ring_flush(&tm->to_pty, tm->pty_fd);
+
+save:
+  memcpy(tm->iac, s, tm->iaclen = e-s);
+
+  return ring_flush(&tm->to_pty, tm->pty_fd);
+}
+
+// Queue pty output for the socket, doubling any IAC bytes in it
+static int pty_to_net(struct term_session *tm)
+{
+  unsigned char *s = (void *)toybuf, *e, *p;
+  int len = minof(ring_free(&tm->to_net)/2, sizeof(toybuf));
+
+  if ((len = read_nonblock(tm->pty_fd, s, len)) < 1) return len;
+  for (e = s+len; s < e; s = p) {
+    p = memchr(s, IAC, e-s);
+    p = p ? p+1 : e;
+    ring_put(&tm->to_net, s, p-s);
+    if (p[-1] == IAC) ring_put(&tm->to_net, p-1, 1);
   }
-  memcpy(start, toybuf, i);
-  memcpy(start + i, end - tm->rem, tm->rem); //put remaining if we break;
-  return i;
+
+  return ring_flush(&tm->to_net, tm->net_out);
 }
 
-static int dup_iacs(char *start, int fd, int len)
+static void set_events(int fd, int *old, int events)
 {
-  char arr[] = {IAC, IAC};
-  char *needle = NULL;
-  int ret = 0, c, count = 0;
+  struct epoll_event ev;
 
-  while (len) {
-    if (*start == IAC) {
-      count = writeall(fd, arr, sizeof(arr));
-      if (count != 2) break; //short write
-      start++;
-      ret++;
-      len--;
-      continue;
-    }
-    needle = memchr(start, IAC, len);
-    if (needle) c = needle - start;
-    else c = len;
-    count = writeall(fd, start, c);
-    if (count < 0) break; 
-    len -= count;
-    ret += count;
-    start += count;
+  if (*old == events) return;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = *old = events;
+  ev.data.fd = fd;
+  epoll_ctl(TT.epfd, EPOLL_CTL_MOD, fd, &ev);
+}
+
+// Only ask to read when there's room to put the data and to write when
+// there's something queued, so a slow side stalls its peer instead of spinning
+static void update_session(struct term_session *tm)
+{
+  int in = 0, out = 0, pty = 0;
+
+  if (ring_free(&tm->to_pty) > sizeof(tm->iac)) in = EPOLLIN;
+  if (ring_used(&tm->to_net)) out = EPOLLOUT;
+  if (ring_free(&tm->to_net) > 1) pty = EPOLLIN;
+  if (ring_used(&tm->to_pty)) pty |= EPOLLOUT;
+
+  if (tm->net_in == tm->net_out) set_events(tm->net_in, tm->ev, in|out);
+  else {
+    set_events(tm->net_in, tm->ev, in);
+    set_events(tm->net_out, tm->ev+1, out);
+  }
+  set_events(tm->pty_fd, tm->ev+2, pty);
+}
+
+static void add_fd(int fd, struct term_session *tm, int events)
+{
+  struct epoll_event ev;
+
+  if (fd >= TT.nfds) {
+    TT.fds = xrealloc(TT.fds, (fd+64)*sizeof(*TT.fds));
+    memset(TT.fds+TT.nfds, 0, (fd+64-TT.nfds)*sizeof(*TT.fds));
+    TT.nfds = fd+64;
   }
-  return ret;
+  TT.fds[fd] = tm;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = events;
+  ev.data.fd = fd;
+  if (epoll_ctl(TT.epfd, EPOLL_CTL_ADD, fd, &ev)) perror_exit("epoll_ctl");
+}
+
+static void del_fd(int fd)
+{
+  epoll_ctl(TT.epfd, EPOLL_CTL_DEL, fd, 0);
+  TT.fds[fd] = 0;
+  close(fd);
+}
+
+static void add_session(int net_fd)
+{
+  struct term_session *tm = xzalloc(sizeof(struct term_session));
+
+  tm->pty_fd = new_session(net_fd);
+  tm->child_pid = TT.fork_pid;
+  tm->net_in = net_fd;
+  tm->net_out = net_fd + !!FLAG(i);
+  add_fd(tm->net_in, tm, 0);
+  if (tm->net_out != tm->net_in) add_fd(tm->net_out, tm, 0);
+  add_fd(tm->pty_fd, tm, 0);
+  update_session(tm);
+  tm->next = TT.sessions;
+  TT.sessions = tm;
+}
+
+// Closing the pty hangs up login, the session is freed when it's reaped
+static void close_session(struct term_session *tm)
+{
+  if (tm->pty_fd < 0) return;
+  // Pass on whatever login said last before it went away
+  pty_to_net(tm);
+  ring_flush(&tm->to_net, tm->net_out);
+  if (FLAG(i)) exit(EXIT_SUCCESS);
+  del_fd(tm->pty_fd);
+  del_fd(tm->net_in);
+  tm->pty_fd = tm->net_in = tm->net_out = -1;
 }
 
 void telnetd_main(void)
 {
-  errno = 0;
-  fd_set rd, wr;
-  struct term_session *tm = NULL;
-  struct timeval tv, *tv_ptr = NULL;
-  int pty_fd, new_fd, c = 0, w, master_fd = 0;
-  int inetd_m = toys.optflags & FLAG_i;
+  struct epoll_event evs[64];
+  struct term_session *tm, **prev;
+  int i, n, fd, err, timeout = -1, master_fd = -1;
 
   if (!(toys.optflags & FLAG_l)) TT.login_path = "/bin/login";
   if (!(toys.optflags & FLAG_f)) TT.issue_path = "/etc/issue.net";
   if (toys.optflags & FLAG_w) toys.optflags |= FLAG_F;
-  if (!inetd_m) {
+  if (!FLAG(i)) {
     master_fd = listen_socket();
     fcntl(master_fd, F_SETFD, FD_CLOEXEC);
-    if (master_fd > TT.gmax_fd) TT.gmax_fd = master_fd;
     if (!(toys.optflags & FLAG_F)) daemon(0, 0); 
-  } else {
-    pty_fd = new_session(master_fd); //master_fd = 0
-    if (pty_fd > TT.gmax_fd) TT.gmax_fd = pty_fd;
-    tm = xzalloc(sizeof(struct term_session));
-    tm->child_pid = TT.fork_pid;
-    tm->new_fd = 0;    
-    tm->pty_fd = pty_fd;    
-    if (session_list) {     
-      tm->next = session_list;
-      session_list = tm;    
-    } else session_list = tm;
   }
-
-  if ((toys.optflags & FLAG_w) && !session_list) {
-    tv.tv_sec = TT.w_sec;
-    tv.tv_usec = 0;
-    tv_ptr = &tv;
-  }                
+  if ((TT.epfd = epoll_create1(EPOLL_CLOEXEC)) < 0) perror_exit("epoll");
+  if (FLAG(i)) add_session(0);
+  else {
+    add_fd(master_fd, 0, EPOLLIN);
+    if (FLAG(w)) timeout = TT.w_sec*1000;
+  }
   signal(SIGCHLD, generic_signal);
 
   for (;;) {
-    FD_ZERO(&rd);
-    FD_ZERO(&wr);
-    if (!inetd_m) FD_SET(master_fd, &rd);
-
-    tm = session_list;
-    while (tm) {
-
-      if (tm->pty_fd > 0 && tm->buff1_avail < BUFSIZE) FD_SET(tm->pty_fd, &rd);
-      if (tm->new_fd >= 0 && tm->buff2_avail < BUFSIZE) FD_SET(tm->new_fd, &rd);
-      if (tm->pty_fd > 0 && (tm->buff2_avail - tm->buff2_written) > 0)  
-        FD_SET(tm->pty_fd, &wr);
-      if (tm->new_fd >= 0 && (tm->buff1_avail - tm->buff1_written) > 0)  
-        FD_SET(tm->new_fd, &wr);
-      tm = tm->next;
-    }
-
-
-    int r = select(TT.gmax_fd + 1, &rd, &wr, NULL, tv_ptr);
-    if (!r) return; //timeout
-    if (r < -1) continue;
-
-    if (!inetd_m && FD_ISSET(master_fd, &rd)) { //accept new connection
-      new_fd = accept(master_fd, NULL, NULL);
-      if (new_fd < 0) continue;
-      tv_ptr = NULL;
-      fcntl(new_fd, F_SETFD, FD_CLOEXEC);
-      if (new_fd > TT.gmax_fd) TT.gmax_fd = new_fd;
-      pty_fd = new_session(new_fd);
-      if (pty_fd > TT.gmax_fd) TT.gmax_fd = pty_fd;
-
-      tm = xzalloc(sizeof(struct term_session));
-      tm->child_pid = TT.fork_pid;
-      tm->new_fd = new_fd;
-      tm->pty_fd = pty_fd;
-      if (session_list) {
-        tm->next = session_list;
-        session_list = tm;
-      } else session_list = tm;
-    }
-
-    tm = session_list;
-    for (;tm;tm=tm->next) {
-      if (FD_ISSET(tm->pty_fd, &rd)) {
-        if ((c = read(tm->pty_fd, tm->buff1 + tm->buff1_avail,
-                BUFSIZE-tm->buff1_avail)) <= 0) break;
-        tm->buff1_avail += c;
-        if ((w = dup_iacs(tm->buff1 + tm->buff1_written, tm->new_fd + inetd_m,
-                tm->buff1_avail - tm->buff1_written)) < 0) break;
-        tm->buff1_written += w;
-      }
-      if (FD_ISSET(tm->new_fd, &rd)) {
-        if ((c = read(tm->new_fd, tm->buff2+tm->buff2_avail,
-                BUFSIZE-tm->buff2_avail)) <= 0) break;
-        c = handle_iacs(tm, c, tm->pty_fd);
-        tm->buff2_avail += c;
-        if ((w = write(tm->pty_fd, tm->buff2+ tm->buff2_written, 
-                tm->buff2_avail - tm->buff2_written)) < 0) break;
-        tm->buff2_written += w;
-      }
-      if (FD_ISSET(tm->pty_fd, &wr)) {
-        if ((w = write(tm->pty_fd,  tm->buff2 + tm->buff2_written, 
-                tm->buff2_avail - tm->buff2_written)) < 0) break;
-        tm->buff2_written += w;
-      }
-      if (FD_ISSET(tm->new_fd, &wr)) {
-        if ((w = dup_iacs(tm->buff1 + tm->buff1_written, tm->new_fd + inetd_m,
-                tm->buff1_avail - tm->buff1_written)) < 0) break;
-        tm->buff1_written += w;
-      }
-      if (tm->buff1_written == tm->buff1_avail)
-        tm->buff1_written = tm->buff1_avail = 0;
-      if (tm->buff2_written == tm->buff2_avail)
-        tm->buff2_written = tm->buff2_avail = 0;
-      fflush(NULL);
-    }
-
     // Loop to handle (unknown number of) SIGCHLD notifications
     while (toys.signal) {
       int status;
-      struct term_session *prev = NULL;
       pid_t pid;
 
       // funny little dance to avoid race conditions.
       toys.signal = 0;
       pid = waitpid(-1, &status, WNOHANG);
-      if (pid < 0) break;
+      if (pid < 1) break;
       toys.signal++;
 
-
-      for (tm = session_list; tm; tm = tm->next) {
+      for (prev = &TT.sessions; (tm = *prev); prev = &tm->next)
         if (tm->child_pid == pid) break;
-        prev = tm;
-      }
-      if (!tm) return; // reparented child we don't care about
+      if (!tm) continue; // reparented child we don't care about
 
-      if (toys.optflags & FLAG_i) exit(EXIT_SUCCESS);
-      if (!prev) session_list = session_list->next;
-      else prev->next = tm->next;
+      close_session(tm);
+      *prev = tm->next;
       utmp_entry();
-      xclose(tm->pty_fd);
-      xclose(tm->new_fd);
       free(tm);
     }
+
+    if (!(n = epoll_wait(TT.epfd, evs, ARRAY_LEN(evs), timeout))) return;
+    if (n < 0) {
+      if (errno != EINTR) perror_exit("epoll_wait");
+      continue;
+    }
+
+    for (i = 0; i < n; i++) {
+      fd = evs[i].data.fd;
+      if (fd == master_fd) {
+        if ((fd = accept(master_fd, NULL, NULL)) < 0) continue;
+        timeout = -1;
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        add_session(fd);
+        continue;
+      }
+
+      // Skip stale events for sessions closed earlier in this batch
+      if (!(tm = TT.fds[fd])) continue;
+      err = 0;
+      if (evs[i].events & (EPOLLERR|EPOLLHUP)) evs[i].events |= EPOLLIN;
+      if (fd == tm->pty_fd) {
+        if (evs[i].events & EPOLLOUT) err = ring_flush(&tm->to_pty, fd);
+        if (!err && (evs[i].events & EPOLLIN)) err = pty_to_net(tm);
+      } else {
+        if (fd == tm->net_out && (evs[i].events & EPOLLOUT))
+          err = ring_flush(&tm->to_net, fd);
+        if (!err && fd == tm->net_in && (evs[i].events & EPOLLIN))
+          err = net_to_pty(tm);
+      }
+      if (err) close_session(tm);
+      else update_session(tm);
+    }
   }
 }
@@ -5,7 +5,7 @@
  *
  * No Standard.
 
-USE_TFTP(NEWTOY(tftp, "<1b#<8>65464r:l:g|p|[!gp]", TOYFLAG_USR|TOYFLAG_BIN))
+USE_TFTP(NEWTOY(tftp, "<1w#<1>65535=1b#<8>65464r:l:g|p|[!gp]", TOYFLAG_USR|TOYFLAG_BIN))
 
 config TFTP
   bool "tftp"
@@ -20,21 +20,25 @@ config TFTP
     -g    Get file
     -p    Put file
     -b SIZE Transfer blocks of SIZE octets(8 <= SIZE <= 65464)
+    -w NUM  Send NUM blocks before waiting for an ACK (RFC 7440, default 1)
 */
 #define FOR_tftp
 #include "toys.h"
+#include <sys/uio.h>
 
 GLOBALS(
   char *local_file;
   char *remote_file;
   long block_size;
+  long window;
 
   struct sockaddr_storage inaddr;
   int af;
 )
 
 #define TFTP_BLKSIZE    512
-#define TFTP_RETRIES    3
+#define TFTP_RETRIES    12
+#define TFTP_TIMEOUT    100 // ms, plus 150 more for each retry
 #define TFTP_DATAHEADERSIZE 4
 #define TFTP_MAXPACKETSIZE  (TFTP_DATAHEADERSIZE + TFTP_BLKSIZE)
 #define TFTP_PACKETSIZE    TFTP_MAXPACKETSIZE
@@ -50,6 +54,7 @@ GLOBALS(
 
 #define TFTP_ER_ILLEGALOP  4  /* Illegal TFTP operation */
 #define TFTP_ER_UNKID    5  /* Unknown transfer ID */
+#define TFTP_ER_NEGOTIATE  8  /* Terminate transfer due to option negotiation */
 
 #define TFTP_ES_NOSUCHFILE  "File not found"
 #define TFTP_ES_ACCESS    "Access violation"
@@ -63,12 +68,9 @@ GLOBALS(
 // Initializes SERVER with ADDR and returns socket.
 static int init_tftp(struct sockaddr_storage *server)
 {
-  struct timeval to = { .tv_sec = 10, //Time out
-                        .tv_usec = 0 };
   const int set = 1;
   int port = 69, sd = xsocket(TT.af, SOCK_DGRAM, IPPROTO_UDP);
 
-  xsetsockopt(sd, SOL_SOCKET, SO_RCVTIMEO, (void *)&to, sizeof(struct timeval));
   xsetsockopt(sd, SOL_SOCKET, SO_REUSEADDR, (void *)&set, sizeof(set));
 
   if(toys.optc == 2) port = atolx_range(toys.optargs[1], 1, 65535);
@@ -94,11 +96,21 @@ static int init_tftp(struct sockaddr_storage *server)
  */
 static int mkpkt_request(uint8_t *buffer, int opcode, char *path, int mode)
 {
+  int len;
+
   buffer[0] = opcode >> 8;
   buffer[1] = opcode & 0xff;
   if(strlen(path) > TFTP_BLKSIZE) error_exit("path too long");
-  return sprintf((char*) &buffer[2], "%s%c%s", path, 0, 
+  len = sprintf((char*) &buffer[2], "%s%c%s", path, 0,
     (mode ? "octet" : "netascii")) + 3;
+
+  // RFC 2347 options, "name\0value\0"
+  if (TT.block_size)
+    len += sprintf((char*) &buffer[len], "blksize%c%ld", 0, TT.block_size) + 1;
+  if (TT.window > 1)
+    len += sprintf((char*) &buffer[len], "windowsize%c%ld", 0, TT.window) + 1;
+
+  return len;
 }
 
 /*
@@ -128,31 +140,42 @@ static int mkpkt_err(uint8_t *buffer, uint16_t errorcode, char *errormsg)
   return strlen(errormsg) + 5;
 }
 
+// Port of SA, which is the server's transfer ID once it's answered.
+static in_port_t *sa_port(struct sockaddr_storage *sa)
+{
+  if (TT.af == AF_INET6) return &((struct sockaddr_in6 *)sa)->sin6_port;
+
+  return &((struct sockaddr_in *)sa)->sin_port;
+}
+
 /*
- * Recieves data from server in BUFF with socket SD and updates FROM
- * and returns read length.
+ * Waits TIMEOUT ms for data from server in BUFF with socket SD, updates FROM
+ * and returns read length, or -1 with errno EAGAIN if nothing came.
  */
 static ssize_t read_server(int sd, void *buf, size_t len,
-  struct sockaddr_storage *from)
+  struct sockaddr_storage *from, int timeout)
 {
+  struct pollfd pfd;
   socklen_t alen;
   ssize_t nb;
-  
+
+  pfd.fd = sd;
+  pfd.events = POLLIN;
   for (;;) {
-    memset(buf, 0, len);
-    alen = sizeof(struct sockaddr_storage);
-    nb = recvfrom(sd, buf, len, 0, (struct sockaddr *) from, &alen);
-    if (nb < 0) {
-      if (errno == EAGAIN) {
-        perror_msg("server read timed out");
-        return nb;
-      }else if (errno != EINTR) {
-        perror_msg("server read failed");
-        return nb;
-      }
-    }else return nb;
+    if (!(nb = poll(&pfd, 1, timeout))) {
+      errno = EAGAIN;
+      return -1;
+    }
+    if (nb > 0) {
+      alen = sizeof(struct sockaddr_storage);
+      nb = recvfrom(sd, buf, len, 0, (struct sockaddr *) from, &alen);
+      if (nb >= 0) return nb;
+    }
+    if (errno != EINTR) {
+      perror_msg("server read failed");
+      return nb;
+    }
   }
-  return nb;
 }
 
 /*
@@ -163,7 +186,7 @@ static ssize_t write_server(int sd, void *buf, size_t len,
   struct sockaddr_storage *to)
 {
   ssize_t nb;
-  
+
   for (;;) {
     nb = sendto(sd, buf, len, 0, (struct sockaddr *)to,
             sizeof(struct sockaddr_storage));
@@ -177,254 +200,290 @@ static ssize_t write_server(int sd, void *buf, size_t len,
   return nb;
 }
 
-// checks packet for data and updates block no
-static inline int check_data( uint8_t *packet, uint16_t *opcode, 
-  uint16_t *blockno)
+// Checks that a packet FROM came from SERVER, taking the server's port the
+// first time it answers. Returns 0 if it did.
+static int check_from(int sd, struct sockaddr_storage *server,
+  struct sockaddr_storage *from)
 {
-  *opcode = (uint16_t) packet[0] << 8 | (uint16_t) packet[1];
-  if (*opcode == TFTP_OP_DATA) {
-    *blockno = (uint16_t) packet[2] << 8 | (uint16_t) packet[3];
-    return 0;
+  int len;
+
+  if ( ((TT.af == AF_INET) &&
+          memcmp(&((struct sockaddr_in *)server)->sin_addr,
+          &((struct sockaddr_in *)from)->sin_addr,
+          sizeof(struct in_addr))) ||
+       ((TT.af == AF_INET6) &&
+          memcmp(&((struct sockaddr_in6 *)server)->sin6_addr,
+          &((struct sockaddr_in6 *)from)->sin6_addr,
+          sizeof(struct in6_addr)))) {
+    error_msg("Invalid address in DATA.");
+    return -1;
   }
-  return -1;
+  if (!*sa_port(server)) *sa_port(server) = *sa_port(from);
+  else if (*sa_port(server) != *sa_port(from)) {
+    error_msg("Invalid port in DATA.");
+    len = mkpkt_err((void *)toybuf, TFTP_ER_UNKID, TFTP_ES_UNKID);
+    write_server(sd, toybuf, len, from);
+    return -1;
+  }
+
+  return 0;
 }
 
-// Makes data packet through FD from file OFFSET in buffer PACKET of BLOCKNO
-static int mkpkt_data(int fd, off_t offset, uint8_t *packet, uint16_t blockno)
+// Reports an ERROR packet, or answers an unknown opcode with one.
+// Returns 1 for an error packet, which ends the transfer.
+static int check_err(int sd, uint8_t *packet, struct sockaddr_storage *server)
 {
-  off_t tmp;
-  int nbytesread;
-
-  packet[0] = TFTP_OP_DATA >> 8;
-  packet[1] = TFTP_OP_DATA & 0xff;
-  packet[2] = blockno >> 8;
-  packet[3] = blockno & 0xff;
-  tmp = lseek(fd, offset, SEEK_SET);
-  if (tmp == (off_t) -1) {
-    perror_msg("lseek failed");
-    return -1;
+  uint16_t opcode = (uint16_t) packet[0] << 8 | (uint16_t) packet[1],
+    code = (uint16_t) packet[2] << 8 | (uint16_t) packet[3];
+  int len;
+
+  if (opcode == TFTP_OP_ERR) {
+    char *message = "DATA Check failure.";
+    char *arr[] = {TFTP_ES_NOSUCHFILE, TFTP_ES_ACCESS,
+      TFTP_ES_FULL, TFTP_ES_ILLEGALOP,
+      TFTP_ES_UNKID, TFTP_ES_EXISTS,
+      TFTP_ES_UNKUSER, TFTP_ES_NEGOTIATE};
+
+    if (code && (code < 9)) message = arr[code - 1];
+    error_msg_raw(message);
+
+    return 1;
+  }
+  if (opcode > 6) {
+    len = mkpkt_err((void *)toybuf, TFTP_ER_ILLEGALOP, TFTP_ES_ILLEGALOP);
+    write_server(sd, toybuf, len, server);
   }
-  nbytesread = readall(fd, &packet[TFTP_DATAHEADERSIZE], TFTP_DATASIZE);
-  if (nbytesread < 0) return -1;
-  return nbytesread + TFTP_DATAHEADERSIZE;
+
+  return 0;
 }
 
-// Receives ACK responses from server and updates blockno
-static int read_ack(int sd, uint8_t *packet, struct sockaddr_storage *server,
-  uint16_t *port, uint16_t *blockno)
+// Takes the options the server agreed to from OACK packet of LEN bytes.
+// Returns -1 (after telling the server) for values we didn't ask for.
+static int parse_oack(int sd, uint8_t *packet, int len,
+  struct sockaddr_storage *server, int *blksize, int *window)
 {
-  struct sockaddr_storage from;
-  ssize_t nbytes;
-  uint16_t opcode, rblockno;
-  int packetlen, retry;
-
-  for (retry = 0; retry < TFTP_RETRIES; retry++) {
-    for (;;) {
-      nbytes = read_server(sd, packet, TFTP_IOBUFSIZE, &from);
-      if (nbytes < 4) { // Ack headersize = 4
-        if (nbytes == 0) error_msg("Connection lost.");
-        else if (nbytes > 0) error_msg("Short packet: %d bytes", nbytes);
-        else error_msg("Server read ACK failure.");
-        break;
-      } else {
-        if (!*port) {
-          *port = ((struct sockaddr_in *)&from)->sin_port;
-          ((struct sockaddr_in *)server)->sin_port =
-                  ((struct sockaddr_in *)&from)->sin_port;
-        }
-        if (((struct sockaddr_in *)server)->sin_addr.s_addr !=
-                ((struct sockaddr_in *)&from)->sin_addr.s_addr) {
-          error_msg("Invalid address in DATA.");
-          continue;
-        }
-        if (*port != ((struct sockaddr_in *)server)->sin_port) {
-          error_msg("Invalid port in DATA.");
-          packetlen = mkpkt_err(packet, TFTP_ER_UNKID, TFTP_ES_UNKID);
-          (void) write_server(sd, packet, packetlen, server);
-          continue;
-        }
-        opcode = (uint16_t) packet[0] << 8 | (uint16_t) packet[1];
-        rblockno = (uint16_t) packet[2] << 8 | (uint16_t) packet[3];
-
-        if (opcode != TFTP_OP_ACK) {
-          error_msg("Bad opcode.");
-          if (opcode > 5) {
-            packetlen = mkpkt_err(packet, TFTP_ER_ILLEGALOP, TFTP_ES_ILLEGALOP);
-            (void) write_server(sd, packet, packetlen, server);
-          }
-          break;
-        }
-        if (blockno) *blockno = rblockno;
-        return 0;
-      }
+  char *s = (char *)packet+2, *end = (char *)packet+len, *val;
+  long n;
+
+  while (s < end && (val = memchr(s, 0, end-s)) && ++val < end
+      && memchr(val, 0, end-val)) {
+    n = strtol(val, 0, 10);
+    if (!strcasecmp(s, "blksize")) {
+      if (n < 8 || n > TT.block_size) break;
+      *blksize = n;
+    } else if (!strcasecmp(s, "windowsize")) {
+      if (n < 1 || n > TT.window) break;
+      *window = n;
     }
+    s = val+strlen(val)+1;
   }
-  error_msg("Timeout, Waiting for ACK.");
+  if (s >= end) return 0;
+
+  len = mkpkt_err(packet, TFTP_ER_NEGOTIATE, TFTP_ES_NEGOTIATE);
+  write_server(sd, packet, len, server);
+  error_msg_raw(TFTP_ES_NEGOTIATE);
+
   return -1;
 }
 
-// receives file from server.
+// receives file from server, acknowledging each window of blocks.
 static int file_get(void)
 {
-  struct sockaddr_storage server, from;
-  uint8_t *packet;
-  uint16_t blockno = 0, opcode, rblockno = 0;
-  int len, sd, fd, retry, nbytesrecvd = 0, ndatabytes, ret, result = -1;
-
-  sd = init_tftp(&server);
-
-  packet = (uint8_t*) xzalloc(TFTP_IOBUFSIZE);
+  struct sockaddr_storage req, server, from;
+  uint8_t *packet, *out;
+  uint16_t blockno = 1, opcode;
+  int len, sd, fd, retry = 0, result = -1, inwin = 0, nakked = 0, last = 0,
+    timeout = TFTP_TIMEOUT, blksize = TFTP_BLKSIZE, window = 1, outlen,
+    bufsize = TFTP_IOBUFSIZE + TT.block_size;
+
+  sd = init_tftp(&req);
+  memcpy(&server, &req, sizeof(server));
+  *sa_port(&server) = 0;
+
+  packet = (uint8_t*) xzalloc(bufsize);
+  out = (uint8_t*) xzalloc(TFTP_IOBUFSIZE + 64);
   fd = xcreate(TT.local_file, O_WRONLY | O_CREAT | O_TRUNC, 0666);
 
-  len = mkpkt_request(packet, TFTP_OP_RRQ, TT.remote_file, 1);
-  ret = write_server(sd, packet, len, &server);
-  if (ret != len){
-    unlink(TT.local_file);
-    goto errout_with_sd;
-  }
-  if (TT.af == AF_INET6) ((struct sockaddr_in6 *)&server)->sin6_port = 0;
-  else ((struct sockaddr_in *)&server)->sin_port = 0;
-
-  do {
-    blockno++;
-    for (retry = 0 ; retry < TFTP_RETRIES; retry++) {
-      nbytesrecvd = read_server(sd, packet, TFTP_IOBUFSIZE, &from);
-      if (nbytesrecvd > 0) {
-        if ( ((TT.af == AF_INET) &&
-                memcmp(&((struct sockaddr_in *)&server)->sin_addr,
-                &((struct sockaddr_in *)&from)->sin_addr,
-                sizeof(struct in_addr))) ||
-             ((TT.af == AF_INET6) &&
-                memcmp(&((struct sockaddr_in6 *)&server)->sin6_addr,
-                &((struct sockaddr_in6 *)&from)->sin6_addr,
-                sizeof(struct in6_addr)))) {
-          error_msg("Invalid address in DATA.");
-          retry--;
-          continue;
-        }
-        if ( ((TT.af == AF_INET) && ((struct sockaddr_in *)&server)->sin_port
-                && (((struct sockaddr_in *)&server)->sin_port !=
-                ((struct sockaddr_in *)&from)->sin_port)) ||
-             ((TT.af == AF_INET6) && ((struct sockaddr_in6 *)&server)->sin6_port
-                && (((struct sockaddr_in6 *)&server)->sin6_port !=
-                ((struct sockaddr_in6 *)&from)->sin6_port))) {
-          error_msg("Invalid port in DATA.");
-          len = mkpkt_err(packet, TFTP_ER_UNKID, TFTP_ES_UNKID);
-          ret = write_server(sd, packet, len, &from);
-          retry--;
-          continue;
-        }
-        if (nbytesrecvd < TFTP_DATAHEADERSIZE) {
-          error_msg("Tiny data packet ignored.");
-          continue;
-        }
-        if (check_data(packet, &opcode, &rblockno) != 0
-            || blockno != rblockno) {
-
-        if (opcode == TFTP_OP_ERR) {
-          char *message = "DATA Check failure.";
-            char *arr[] = {TFTP_ES_NOSUCHFILE, TFTP_ES_ACCESS,
-              TFTP_ES_FULL, TFTP_ES_ILLEGALOP,
-              TFTP_ES_UNKID, TFTP_ES_EXISTS,
-              TFTP_ES_UNKUSER, TFTP_ES_NEGOTIATE};
-            if (rblockno && (rblockno < 9)) message = arr[rblockno - 1];
-            error_msg_raw(message);
-        }
-        else if (blockno == 1 && opcode == TFTP_OP_OACK) {
-          len = mkpkt_ack(packet, 0);
-          ret = write_server(sd, packet, len, &from);
-          if (ret != len){
-            unlink(TT.local_file);
-            goto errout_with_sd;
-          }
-        }
-        else if (opcode > 5) {
-          len = mkpkt_err(packet, TFTP_ER_ILLEGALOP, TFTP_ES_ILLEGALOP);
-          ret = write_server(sd, packet, len, &from);
+  // Send the request, then our latest ACK, until the last block arrives.
+  outlen = mkpkt_request(out, TFTP_OP_RRQ, TT.remote_file, 1);
+  for (;;) {
+    len = write_server(sd, out, outlen, *sa_port(&server) ? &server : &req);
+    if (len != outlen) goto errout_with_sd;
+    if (last) break;
+
+    for (;;) {
+      if ((len = read_server(sd, packet, bufsize, &from, timeout)) < 0) {
+        if (errno != EAGAIN) goto errout_with_sd;
+        if (++retry > TFTP_RETRIES) {
+          error_msg("Retry limit exceeded.");
+          goto errout_with_sd;
         }
+        timeout += 150;
+        inwin = nakked = 0;
+        break;
+      }
+      if (check_from(sd, &server, &from)) continue;
+      if (len < TFTP_DATAHEADERSIZE) {
+        error_msg("Tiny data packet ignored.");
         continue;
-        }
-        if ((TT.af == AF_INET6) && !((struct sockaddr_in6 *)&server)->sin6_port)
-          ((struct sockaddr_in6 *)&server)->sin6_port =
-            ((struct sockaddr_in6 *)&from)->sin6_port;
-        else if ((TT.af == AF_INET) && !((struct sockaddr_in *)&server)->sin_port)
-          ((struct sockaddr_in *)&server)->sin_port =
-            ((struct sockaddr_in *)&from)->sin_port;
+      }
+      if (check_err(sd, packet, &server)) goto errout_with_sd;
+      opcode = (uint16_t) packet[0] << 8 | (uint16_t) packet[1];
+      if (opcode == TFTP_OP_OACK && blockno == 1) {
+        if (parse_oack(sd, packet, len, &server, &blksize, &window))
+          goto errout_with_sd;
+        // A whole window can arrive at once, so make room for it
+        len = minof(2LL*window*(blksize+TFTP_DATAHEADERSIZE), INT_MAX);
+        setsockopt(sd, SOL_SOCKET, SO_RCVBUF, &len, sizeof(len));
+        outlen = mkpkt_ack(out, 0);
+        retry = 0;
         break;
       }
-    }
-    if (retry == TFTP_RETRIES) {
-      error_msg("Retry limit exceeded.");
-      unlink(TT.local_file);
-      goto errout_with_sd;
-    }
-    ndatabytes = nbytesrecvd - TFTP_DATAHEADERSIZE;
-    if (writeall(fd, packet + TFTP_DATAHEADERSIZE, ndatabytes) < 0){
-      unlink(TT.local_file);
-      goto errout_with_sd;
-    }
-    len = mkpkt_ack(packet, blockno);
-    ret = write_server(sd, packet, len, &server);
-    if (ret != len){
-      unlink(TT.local_file);
-      goto errout_with_sd;
-    }
-  } while (ndatabytes >= TFTP_DATASIZE);
+      if (opcode != TFTP_OP_DATA) continue;
 
+      // Out of order: ACK the last block we have, once, to restart there.
+      if (((uint16_t) packet[2] << 8 | (uint16_t) packet[3]) != blockno) {
+        if (nakked || (blockno == 1 && outlen != 4)) continue;
+        nakked = 1;
+        inwin = 0;
+        break;
+      }
+      if (writeall(fd, packet + TFTP_DATAHEADERSIZE, len - 4) != len - 4)
+        goto errout_with_sd;
+      outlen = mkpkt_ack(out, blockno++);
+      retry = nakked = 0;
+      timeout = TFTP_TIMEOUT;
+      if (len - 4 < blksize) last = 1;
+      if (++inwin == window || last) {
+        inwin = 0;
+        break;
+      }
+    }
+  }
   result = 0;
 
 errout_with_sd: xclose(sd);
+  if (result) unlink(TT.local_file);
+  close(fd);
   free(packet);
+  free(out);
   return result;
 }
 
-// Sends file to server.
+// Sends file to server a window of blocks at a time, reading each chunk of
+// the window with one preadv() into the data packets.
 int file_put(void)
 {
-  struct sockaddr_storage server;
-  uint8_t *packet;
-  off_t offset = 0;
-  uint16_t blockno = 1, rblockno, port = 0;
-  int packetlen, sd, fd, retry = 0, ret, result = -1;
-
-  sd = init_tftp(&server);
-  packet = (uint8_t*)xzalloc(TFTP_IOBUFSIZE);
+  struct sockaddr_storage req, server, from;
+  struct iovec *iov;
+  uint8_t *packet, *pkts;
+  unsigned long long acked = 0, blk = 0;
+  uint16_t opcode;
+  int len, sd, fd, i, n, retry = 0, result = -1, last = 0, nblks, chunk,
+    timeout = TFTP_TIMEOUT, blksize = TFTP_BLKSIZE, window = 1,
+    bufsize = TFTP_IOBUFSIZE + 64;
+
+  sd = init_tftp(&req);
+  memcpy(&server, &req, sizeof(server));
+  *sa_port(&server) = 0;
+  packet = (uint8_t*)xzalloc(bufsize);
   fd = xopenro(TT.local_file);
 
-  for (;;) {  //first loop for request send and confirmation from server.
-    packetlen = mkpkt_request(packet, TFTP_OP_WRQ, TT.remote_file, 1);
-    ret = write_server(sd, packet, packetlen, &server);
-    if (ret != packetlen) goto errout_with_sd;
-    if (read_ack(sd, packet, &server, &port, NULL) == 0) break;
-    if (++retry > TFTP_RETRIES) {
-      error_msg("Retry count exceeded.");
-      goto errout_with_sd;
+  // Send the request until the server ACKs block 0 or sends OACK.
+  for (;;) {
+    len = mkpkt_request(packet, TFTP_OP_WRQ, TT.remote_file, 1);
+    if (write_server(sd, packet, len, &req) != len) goto errout_with_sd;
+    if ((len = read_server(sd, packet, bufsize, &from, timeout)) < 0) {
+      if (errno != EAGAIN) goto errout_with_sd;
+      if (++retry > TFTP_RETRIES) {
+        error_msg("Retry count exceeded.");
+        goto errout_with_sd;
+      }
+      timeout += 150;
+      continue;
     }
+    if (check_from(sd, &server, &from) || len < 4) continue;
+    if (check_err(sd, packet, &server)) goto errout_with_sd;
+    opcode = (uint16_t) packet[0] << 8 | (uint16_t) packet[1];
+    if (opcode == TFTP_OP_OACK) {
+      if (parse_oack(sd, packet, len, &server, &blksize, &window))
+        goto errout_with_sd;
+      break;
+    }
+    if (opcode == TFTP_OP_ACK && !packet[2] && !packet[3]) break;
   }
-  for (;;) {  // loop for data sending and receving ack from server.
-    packetlen = mkpkt_data(fd, offset, packet, blockno);
-    if (packetlen < 0) goto errout_with_sd;
-
-    ret = write_server(sd, packet, packetlen, &server);
-    if (ret != packetlen) goto errout_with_sd;
-
-    if (read_ack(sd, packet, &server, &port, &rblockno) == 0) {
-      if (rblockno == blockno) {
-        if (packetlen < TFTP_PACKETSIZE) break;
-        blockno++;
-        offset += TFTP_DATASIZE;
-        retry = 0;
-        continue;
+
+  chunk = (65536+blksize-1)/blksize;
+  if (chunk > window) chunk = window;
+  pkts = xmalloc(chunk*(blksize+4));
+  iov = xmalloc(chunk*sizeof(*iov));
+  retry = 0;
+  timeout = TFTP_TIMEOUT;
+  for (;;) {
+    for (blk = acked+1; blk <= acked+window && !last; blk += nblks) {
+      nblks = acked+window+1-blk;
+      if (nblks > chunk) nblks = chunk;
+      for (i = 0; i < nblks; i++) {
+        iov[i].iov_base = pkts+i*(blksize+4)+4;
+        iov[i].iov_len = blksize;
+      }
+      if ((n = preadv(fd, iov, nblks, (blk-1)*blksize)) < 0) {
+        perror_msg("read");
+        goto errout_with_pkts;
+      }
+      // A short read holds the last block, which may be empty.
+      if (n < nblks*blksize) {
+        nblks = n/blksize+1;
+        last = 1;
+      }
+      for (i = 0; i < nblks; i++) {
+        uint8_t *p = pkts+i*(blksize+4);
+
+        p[0] = TFTP_OP_DATA >> 8;
+        p[1] = TFTP_OP_DATA & 0xff;
+        p[2] = (blk+i) >> 8;
+        p[3] = (blk+i) & 0xff;
+        len = 4+(i == nblks-1 && last ? n%blksize : blksize);
+        if (write_server(sd, p, len, &server) != len) goto errout_with_pkts;
       }
     }
-    if (++retry > TFTP_RETRIES) {
-      error_msg("Retry count exceeded.");
-      goto errout_with_sd;
+
+    // Wait for an ACK inside the window, resending it all on timeout.
+    for (;;) {
+      if ((len = read_server(sd, packet, bufsize, &from, timeout)) < 0) {
+        if (errno != EAGAIN) goto errout_with_pkts;
+        if (++retry > TFTP_RETRIES) {
+          error_msg("Retry count exceeded.");
+          goto errout_with_pkts;
+        }
+        timeout += 150;
+        last = 0;
+        break;
+      }
+      if (check_from(sd, &server, &from) || len < 4) continue;
+      if (check_err(sd, packet, &server)) goto errout_with_pkts;
+      opcode = (uint16_t) packet[0] << 8 | (uint16_t) packet[1];
+      if (opcode != TFTP_OP_ACK) continue;
+
+      // Block numbers wrap at 65536, so find the ACK's offset into the window
+      i = (uint16_t)(((uint16_t) packet[2] << 8 | packet[3]) - acked);
+      if (i < 1 || i > window || acked+i >= blk) continue;
+      acked += i;
+      if (last && acked == blk-1) {
+        result = 0;
+        goto errout_with_pkts;
+      }
+      last = retry = 0;
+      timeout = TFTP_TIMEOUT;
+      break;
     }
   }
-  result = 0;
 
+errout_with_pkts:
+  free(iov);
+  free(pkts);
 errout_with_sd: close(sd);
+  close(fd);
   free(packet);
   return result;
 }
@@ -23,6 +23,7 @@ config TFTPD
 
 #define FOR_tftpd
 #include "toys.h"
+#include <sys/uio.h>
 
 GLOBALS(
   char *user;
@@ -84,159 +85,263 @@ static void send_errpkt(struct sockaddr *dstaddr,
     perror_exit("sendto failed");
 }
 
-// Used to send / receive packets.
-static void do_action(struct sockaddr *srcaddr, struct sockaddr *dstaddr,
-    socklen_t socklen, char *file, int opcode, int tsize, int blksize)
+// Wait up to TIMEOUT ms for a packet from the client. Returns its length,
+// 0 on timeout, or -1 after reporting an error.
+static int recv_pkt(char *rpkt, int len, int timeout)
 {
-  int fd, done = 0, retry_count = 12, timeout = 100, len;
-  uint16_t blockno = 1, pktopcode, rblockno;
-  char *ptr, *spkt, *rpkt;
   struct pollfd pollfds[1];
-
-  spkt = xzalloc(blksize + 4);
-  rpkt = xzalloc(blksize + 4);
-  ptr = spkt+2; //point after opcode.
+  int poll_ret;
 
   pollfds[0].fd = TT.sfd;
-  // initialize groups, setgid and setuid
-  if (TT.pw) xsetuser(TT.pw);
-
-  if (opcode == TFTPD_OP_RRQ) fd = open(file, O_RDONLY, 0666);
-  else fd = open(file, ((toys.optflags & FLAG_c) ?
-        (O_WRONLY|O_TRUNC|O_CREAT) : (O_WRONLY|O_TRUNC)) , 0666);
-  if (fd < 0) {
-    g_errpkt[3] = TFTPD_ER_NOSUCHFILE;
-    send_errpkt(dstaddr, socklen, "can't open file");
-    goto CLEAN_APP;
-  }
-  // For download -> blockno will be 1.
-  // 1st ACK will be from dst,which will have blockno-=1
-  // Create and send ACK packet.
-  if (blksize != TFTPD_BLKSIZE || tsize) {
-    pktopcode = TFTPD_OP_OACK;
-    // add "blksize\000blksize_val\000" in send buffer.
-    if (blksize != TFTPD_BLKSIZE) {
-      strcpy(ptr, "blksize");
-      ptr += strlen("blksize") + 1;
-      ptr += snprintf(ptr, 6, "%d", blksize) + 1;
+  pollfds[0].events = POLLIN;
+  for (;;) {
+    poll_ret = poll(pollfds, 1, timeout);
+    if (poll_ret < 0 && (errno == EINTR || errno == ENOMEM)) continue;
+    if (poll_ret < 0) {
+      perror_msg("poll");
+      return -1;
     }
-    if (tsize) {// add "tsize\000tsize_val\000" in send buffer.
-      struct stat sb;
-
-      sb.st_size = 0;
-      fstat(fd, &sb);
-      strcpy(ptr, "tsize");
-      ptr += strlen("tsize") + 1;
-      ptr += sprintf(ptr, "%lu", (unsigned long)sb.st_size)+1;
+    if (!poll_ret) return 0;
+    if ((len = read(TT.sfd, rpkt, len)) < 0) {
+      perror_msg("read");
+      return -1;
     }
-    goto SEND_PKT;
+    if (len >= 4) return len;
   }
-  // upload ->  ACK 1st packet with filename, as it has blockno 0.
-  if (opcode == TFTPD_OP_WRQ) blockno = 0;
+}
+
+// Report an ERROR packet from the client. Returns 1 if it was one.
+static int client_err(char *rpkt)
+{
+  char *message = "DATA Check failure.";
+  char *arr[] = {"File not found", "Access violation",
+    "Disk full or allocation exceeded", "Illegal TFTP operation",
+    "Unknown transfer ID", "File already exists",
+    "No such user", "Terminate transfer due to option negotiation"};
+  uint16_t code = ntohs(((uint16_t*)rpkt)[1]);
+
+  if (ntohs(*(uint16_t*)rpkt) != TFTPD_OP_ERR) return 0;
+  if (code && (code < 9)) message = arr[code - 1];
+  error_msg_raw(message);
+
+  return 1;
+}
+
+// Send the file a window of blocks at a time (RFC 7440), reading each chunk
+// of the window with one preadv() into the packets' data fields. An ACK for
+// any block in the window restarts the window after it, so a lost block costs
+// one resend from there. SPKT already holds the OACK to send first, if any.
+static void send_file(struct sockaddr *dstaddr, socklen_t socklen, int fd,
+    char *spkt, int oacklen, int blksize, int window)
+{
+  int i, len, chunk = (65536+blksize-1)/blksize, retry_count = 12,
+    timeout = 100, nblks, last = 0;
+  unsigned long long acked = 0, blk = 0;
+  char *rpkt = xmalloc(blksize + 4), *pkts;
+  struct iovec *iov;
+
+  if (chunk > window) chunk = window;
+  pkts = xmalloc(chunk*(blksize+4));
+  iov = xmalloc(chunk*sizeof(*iov));
 
-  // Prepare DATA and/or ACK pkt and send it.
   for (;;) {
-    int poll_ret;
-
-    retry_count = 12, timeout = 100, pktopcode = TFTPD_OP_ACK;
-    ptr = spkt+2;
-    *((uint16_t*)ptr) = htons(blockno);
-    blockno++;
-    ptr += 2;
-    if (opcode == TFTPD_OP_RRQ) {
-      pktopcode = TFTPD_OP_DATA;
-      len = readall(fd, ptr, blksize);
-      if (len < 0) {
+    // (Re)send the OACK until it's acknowledged with block 0, then data.
+    if (oacklen) {
+      if (sendto(TT.sfd, spkt, oacklen, 0, dstaddr, socklen) < 0)
+        perror_exit("sendto failed");
+    } else for (blk = acked+1; blk <= acked+window && !last; blk += nblks) {
+      nblks = acked+window+1-blk;
+      if (nblks > chunk) nblks = chunk;
+      for (i = 0; i < nblks; i++) {
+        iov[i].iov_base = pkts+i*(blksize+4)+4;
+        iov[i].iov_len = blksize;
+      }
+      if ((len = preadv(fd, iov, nblks, (blk-1)*blksize)) < 0) {
         send_errpkt(dstaddr, socklen, "read-error");
-        break;
+        goto done;
+      }
+      // A short read holds the last block, which may be empty.
+      if (len < nblks*blksize) {
+        nblks = len/blksize+1;
+        last = 1;
+      }
+      for (i = 0; i < nblks; i++) {
+        char *p = pkts+i*(blksize+4);
+
+        ((uint16_t*)p)[0] = htons(TFTPD_OP_DATA);
+        ((uint16_t*)p)[1] = htons(blk+i);
+        if (sendto(TT.sfd, p, 4+(i == nblks-1 && last ? len%blksize : blksize),
+            0, dstaddr, socklen) < 0) perror_exit("sendto failed");
       }
-      if (len != blksize) done = 1; //last pkt.
-      ptr += len;
     }
-SEND_PKT:
-    // 1st ACK will be from dst, which will have blockno-=1
-    *((uint16_t*)spkt) = htons(pktopcode); //append send pkt's opcode.
-RETRY_SEND:
-    if (sendto(TT.sfd, spkt, (ptr - spkt), 0, dstaddr, socklen) <0)
-      perror_exit("sendto failed");
-    // if "block size < 512", send ACK and exit.
-    if ((pktopcode == TFTPD_OP_ACK) && done) break;
 
-POLL_INPUT:
-    pollfds[0].events = POLLIN;
-    pollfds[0].fd = TT.sfd;
-    poll_ret = poll(pollfds, 1, timeout);
-    if (poll_ret < 0 && (errno == EINTR || errno == ENOMEM)) goto POLL_INPUT;
-    if (!poll_ret) {
-      if (!--retry_count) {
-        error_msg("timeout");
+    // Wait for an ACK inside the window, resending it all on timeout.
+    for (;;) {
+      if ((len = recv_pkt(rpkt, blksize + 4, timeout)) < 0) goto done;
+      if (!len) {
+        if (!--retry_count) {
+          error_msg("timeout");
+          goto done;
+        }
+        timeout += 150;
+        last = 0;
         break;
       }
-      timeout += 150;
-      goto RETRY_SEND;
-    } else if (poll_ret == 1) {
-      len = read(pollfds[0].fd, rpkt, blksize + 4);
-      if (len < 0) {
-        send_errpkt(dstaddr, socklen, "read-error");
-        break;
+      if (client_err(rpkt)) goto done;
+      if (ntohs(*(uint16_t*)rpkt) != TFTPD_OP_ACK) continue;
+
+      // Block numbers wrap at 65536, so find the ACK's offset into the window
+      i = (uint16_t)(ntohs(((uint16_t*)rpkt)[1]) - acked);
+      if (oacklen) {
+        if (i) continue;
+        oacklen = 0;
+      } else {
+        if (i < 1 || i > window || acked+i >= blk) continue;
+        acked += i;
+        if (last && acked == blk-1) goto done;
+        last = 0;
       }
-      if (len < 4) goto POLL_INPUT;
-    } else {
-      perror_msg("poll");
+      retry_count = 12, timeout = 100;
       break;
     }
-    // Validate receive packet.
-    pktopcode = ntohs(((uint16_t*)rpkt)[0]);
-    rblockno = ntohs(((uint16_t*)rpkt)[1]);
-    if (pktopcode == TFTPD_OP_ERR) {
-      char *message = "DATA Check failure.";
-      char *arr[] = {"File not found", "Access violation",
-        "Disk full or allocation exceeded", "Illegal TFTP operation",
-        "Unknown transfer ID", "File already exists",
-        "No such user", "Terminate transfer due to option negotiation"};
-
-      if (rblockno && (rblockno < 9)) message = arr[rblockno - 1];
-      error_msg_raw(message);
-      break; // Break the for loop.
-    }
+  }
+
+done:
+  free(iov);
+  free(pkts);
+  free(rpkt);
+}
 
-    // if download requested by client,
-    // server will send data pkt and will receive ACK pkt from client.
-    if ((opcode == TFTPD_OP_RRQ) && (pktopcode == TFTPD_OP_ACK)) {
-      if (rblockno == (uint16_t) (blockno - 1)) {
-        if (!done) continue; // Send next chunk of data.
+// Receive the file, acknowledging each WINDOW blocks (RFC 7440), the last
+// block, or the last block received in order when one goes missing.
+static void recv_file(struct sockaddr *dstaddr, socklen_t socklen, int fd,
+    char *spkt, int acklen, int blksize, int window)
+{
+  int len, retry_count = 12, timeout = 100, inwin = 0, nakked = 0, last = 0;
+  uint16_t blockno = 1;
+  char *rpkt = xmalloc(blksize + 4);
+
+  // A whole window can arrive at once, so make room for it
+  len = minof(2LL*window*(blksize+4), INT_MAX);
+  setsockopt(TT.sfd, SOL_SOCKET, SO_RCVBUF, &len, sizeof(len));
+
+  for (;;) {
+    // ACK (or OACK) everything received so far
+    if (sendto(TT.sfd, spkt, acklen, 0, dstaddr, socklen) < 0)
+      perror_exit("sendto failed");
+    if (last) break;
+
+    for (;;) {
+      if ((len = recv_pkt(rpkt, blksize + 4, timeout)) < 0) goto done;
+      if (!len) {
+        if (!--retry_count) {
+          error_msg("timeout");
+          goto done;
+        }
+        timeout += 150;
+        inwin = nakked = 0;
         break;
       }
-    }
-    
-    // server will receive DATA pkt and write the data.
-    if ((opcode == TFTPD_OP_WRQ) && (pktopcode == TFTPD_OP_DATA)) {
-      if (rblockno == blockno) {
-        int nw = writeall(fd, &rpkt[4], len-4);
-        if (nw != len-4) {
-          g_errpkt[3] = TFTPD_ER_FULL;
-          send_errpkt(dstaddr, socklen, "write error");
-          break;
-        }
-      
-        if (nw != blksize) done = 1;
+      if (client_err(rpkt)) goto done;
+      if (ntohs(*(uint16_t*)rpkt) != TFTPD_OP_DATA) continue;
+
+      // Out of order: say where we are, once, so the window restarts there
+      if (ntohs(((uint16_t*)rpkt)[1]) != blockno) {
+        if (nakked) continue;
+        nakked = 1;
+        inwin = 0;
+        break;
+      }
+      if (writeall(fd, rpkt+4, len-4) != len-4) {
+        g_errpkt[3] = TFTPD_ER_FULL;
+        send_errpkt(dstaddr, socklen, "write error");
+        goto done;
+      }
+      ((uint16_t*)spkt)[0] = htons(TFTPD_OP_ACK);
+      ((uint16_t*)spkt)[1] = htons(blockno++);
+      acklen = 4;
+      retry_count = 12, timeout = 100, nakked = 0;
+      if (len-4 < blksize) last = 1;
+      if (++inwin == window || last) {
+        inwin = 0;
+        break;
       }
-      continue;
     }
-    goto POLL_INPUT;
-  } // end of loop
+  }
+
+done:
+  free(rpkt);
+}
+
+// Used to send / receive packets.
+static void do_action(struct sockaddr *srcaddr, struct sockaddr *dstaddr,
+    socklen_t socklen, char *file, int opcode, int tsize, int blksize,
+    int window)
+{
+  int fd, len;
+  char *ptr, *spkt;
+
+  // Room for an OACK with all our options
+  spkt = xzalloc(64);
+  ptr = spkt+2; //point after opcode.
+
+  // initialize groups, setgid and setuid
+  if (TT.pw) xsetuser(TT.pw);
+
+  if (opcode == TFTPD_OP_RRQ) fd = open(file, O_RDONLY, 0666);
+  else fd = open(file, ((toys.optflags & FLAG_c) ?
+        (O_WRONLY|O_TRUNC|O_CREAT) : (O_WRONLY|O_TRUNC)) , 0666);
+  if (fd < 0) {
+    g_errpkt[3] = TFTPD_ER_NOSUCHFILE;
+    send_errpkt(dstaddr, socklen, "can't open file");
+    goto CLEAN_APP;
+  }
+  // Acknowledge the options we accept: "name\000value\000" for each.
+  if (blksize != TFTPD_BLKSIZE) {
+    strcpy(ptr, "blksize");
+    ptr += strlen("blksize") + 1;
+    ptr += sprintf(ptr, "%d", blksize) + 1;
+  }
+  if (tsize) {
+    struct stat sb;
+
+    sb.st_size = 0;
+    fstat(fd, &sb);
+    strcpy(ptr, "tsize");
+    ptr += strlen("tsize") + 1;
+    ptr += sprintf(ptr, "%lu", (unsigned long)sb.st_size)+1;
+  }
+  if (window != 1) {
+    strcpy(ptr, "windowsize");
+    ptr += strlen("windowsize") + 1;
+    ptr += sprintf(ptr, "%d", window) + 1;
+  }
+  len = ptr-spkt;
+  if (len != 2) *((uint16_t*)spkt) = htons(TFTPD_OP_OACK);
+
+  // For download the client ACKs the OACK as block 0. For upload the
+  // OACK, or an ACK of block 0, starts the transfer.
+  if (opcode == TFTPD_OP_RRQ)
+    send_file(dstaddr, socklen, fd, spkt, len == 2 ? 0 : len, blksize, window);
+  else {
+    if (len == 2) {
+      *((uint16_t*)spkt) = htons(TFTPD_OP_ACK);
+      len = 4;
+    }
+    recv_file(dstaddr, socklen, fd, spkt, len, blksize, window);
+  }
 
 CLEAN_APP:
   if (CFG_TOYBOX_FREE) {
     free(spkt);
-    free(rpkt);
-    close(fd);
+    if (fd >= 0) close(fd);
   }
 }
 
 void tftpd_main(void)
 {
-  int fd = 0, recvmsg_len, rbuflen, opcode, blksize = TFTPD_BLKSIZE, tsize = 0, set =1;
+  int fd = 0, recvmsg_len, opcode, blksize = TFTPD_BLKSIZE, tsize = 0, set = 1,
+    window = 1;
   struct sockaddr_storage srcaddr, dstaddr;
   socklen_t socklen = sizeof(struct sockaddr_storage);
   char *buf = toybuf;
@@ -283,27 +388,26 @@ void tftpd_main(void)
     return;
   }
 
-  //RFC2348. e.g. of size type: "ttype1\0ttype1_val\0...ttypeN\0ttypeN_val\0"
+  // RFC 2347 options: "name1\0value1\0...nameN\0valueN\0"
   buf += strlen(buf) + 1;
-  rbuflen = toybuf + recvmsg_len - buf;
-  if (rbuflen) {
-    int jump = 0, bflag = 0;
-
-    for (; rbuflen; rbuflen -= jump, buf += jump) {
-      if (!bflag && !strcasecmp(buf, "blksize")) { //get blksize
-        errno = 0;
-        blksize = strtoul(buf, NULL, 10);
-        if (errno || blksize > 65564 || blksize < 8) blksize = TFTPD_BLKSIZE;
-        bflag ^= 1;
-      } else if (!tsize && !strcasecmp(buf, "tsize")) tsize ^= 1;
-      
-      jump += strlen(buf) + 1;
-    }
-    tsize &= (opcode == TFTPD_OP_RRQ);
+  while (buf < toybuf+recvmsg_len) {
+    char *val = buf + strlen(buf) + 1;
+    long n;
+
+    if (val >= toybuf+recvmsg_len) break;
+    n = strtol(val, 0, 10);
+    if (!strcasecmp(buf, "blksize")) { // RFC 2348
+      if (n < 8) blksize = TFTPD_BLKSIZE;
+      else blksize = n > 65464 ? 65464 : n;
+    } else if (!strcasecmp(buf, "tsize")) tsize = 1; // RFC 2349
+    else if (!strcasecmp(buf, "windowsize")) // RFC 7440
+      window = n < 1 ? 1 : n > 65535 ? 65535 : n;
+    buf = val + strlen(val) + 1;
   }
+  tsize &= (opcode == TFTPD_OP_RRQ);
 
   //do send / receive file.
   do_action((struct sockaddr*)&srcaddr, (struct sockaddr*)&dstaddr,
-      socklen, toybuf + 2, opcode, tsize, blksize);
+      socklen, toybuf + 2, opcode, tsize, blksize, window);
   if (CFG_TOYBOX_FREE) close(STDIN_FILENO);
 }
@@ -33,8 +33,9 @@ enum {
   class_punct,class_cntrl,class_xdigit,class_invalid
 };
 
-static void map_translation(char *set1 , char *set2)
+static void map_translation(char *s1, char *s2)
 {
+  unsigned char *set1 = (void *)s1, *set2 = (void *)s2;
   int i = TT.len1, k = 0;
 
   if (toys.optflags & FLAG_d)
@@ -208,29 +209,36 @@ save:
   return set;
 }
 
+// Translate stdin a block at a time, deleting and squeezing in place.
 static void print_map(char *set1, char *set2)
 {
-  int r = 0, i, prev_char = -1;
-
-  while (1)
-  {
-    i = 0;
-    r = read(STDIN_FILENO, (toybuf), sizeof(toybuf));
-    if (!r) break;
-    for (;r > i;i++) {
-
-      if ((toys.optflags & FLAG_d) && (TT.map[(int)toybuf[i]] & 0x100)) continue;
-      if (toys.optflags & FLAG_s) {
-        if ((TT.map[(int)toybuf[i]] & 0x200) &&
-            (prev_char == TT.map[(int)toybuf[i]])) {
-          continue;
-        }
+  unsigned char *buf = xmalloc(65536), out[256], *in;
+  int len, i, j, prev = -1;
+
+  for (i = 0; i<256; i++) out[i] = TT.map[i];
+
+  while ((len = xread(0, buf, 65536))) {
+    in = buf;
+    if (FLAG(s)) {
+      for (i = j = 0; i<len; i++) {
+        int m = TT.map[in[i]];
+
+        if ((m&0x100) || ((m&0x200) && m==prev)) continue;
+        buf[j++] = prev = m;
       }
-      xputc(TT.map[(int)toybuf[i]] & 0xFF);
-      prev_char = TT.map[(int)toybuf[i]];
-      fflush(stdout);
-    }
+      len = j;
+
+    // Deletion only: store every byte and advance past the ones kept
+    } else if (FLAG(d)) {
+      for (i = j = 0; i<len; i++) {
+        buf[j] = out[in[i]];
+        j += !(TT.map[in[i]]&0x100);
+      }
+      len = j;
+    } else for (i = 0; i<len; i++) buf[i] = out[buf[i]];
+    xwrite(1, buf, len);
   }
+  if (CFG_TOYBOX_FREE) free(buf);
 }
 
 static void do_complement(char **set)
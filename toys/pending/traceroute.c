@@ -7,17 +7,17 @@
  *
  * No Standard
 
-USE_TRACEROUTE(NEWTOY(traceroute, "<1>2i:f#<1>255=1z#<0>86400=0g*w#<0>86400=5t#<0>255=0s:q#<1>255=3p#<1>65535=33434m#<1>255=30rvndlIUF64", TOYFLAG_STAYROOT|TOYFLAG_USR|TOYFLAG_BIN))
+USE_TRACEROUTE(NEWTOY(traceroute, "<1>2i:f#<1>255=1z#<0>86400=0g*w#<0>86400=5t#<0>255=0s:q#<1>255=3p#<1>65535=33434m#<1>255=30N#<1>65535=1rvndlIUF64", TOYFLAG_STAYROOT|TOYFLAG_USR|TOYFLAG_BIN))
 USE_TRACEROUTE(OLDTOY(traceroute6,traceroute, TOYFLAG_STAYROOT|TOYFLAG_USR|TOYFLAG_BIN))
 config TRACEROUTE
   bool "traceroute"
   default n
   help
-    usage: traceroute [-46FUIldnvr] [-f 1ST_TTL] [-m MAXTTL] [-p PORT] [-q PROBES]
+    usage: traceroute [-46FUIldnvr] [-f 1ST_TTL] [-m MAXTTL] [-N PROBES] [-p PORT] [-q PROBES]
     [-s SRC_IP] [-t TOS] [-w WAIT_SEC] [-g GATEWAY] [-i IFACE] [-z PAUSE_MSEC] HOST [BYTES]
 
-    traceroute6 [-dnrv] [-m MAXTTL] [-p PORT] [-q PROBES][-s SRC_IP] [-t TOS] [-w WAIT_SEC]
-      [-i IFACE] HOST [BYTES]
+    traceroute6 [-dnrv] [-m MAXTTL] [-N PROBES] [-p PORT] [-q PROBES][-s SRC_IP] [-t TOS]
+      [-w WAIT_SEC] [-i IFACE] HOST [BYTES]
 
     Trace the route to HOST
 
@@ -31,6 +31,7 @@ config TRACEROUTE
     -v    verbose
     -r    Bypass routing tables, send directly to HOST
     -m    Max time-to-live (max number of hops)(RANGE 1 to 255)
+    -N    Number of probes in flight at once, across TTLs (default 1)
     -p    Base UDP port number used in probes(default 33434)(RANGE 1 to 65535)
     -q    Number of probes per TTL (default 3)(RANGE 1 to 255)
     -s    IP address to use as the source address
@@ -49,6 +50,7 @@ config TRACEROUTE
 #include <netinet/icmp6.h>
 
 GLOBALS(
+  long inflight;
   long max_ttl;
   long port;
   long ttl_probes;
@@ -81,6 +83,19 @@ struct payload_s {
   uint32_t ident;
 };
 
+// One probe of the trace. Probe seq-1 goes to TTL first_ttl+(seq-1)/probes.
+struct probe {
+  union socksaddr from;
+  unsigned long long sent;
+  unsigned delta;
+  int res, pmtu, len, ttl, type, code;
+  char state;
+};
+
+#define PROBE_SENT 1
+#define PROBE_GOT  2
+#define PROBE_LOST 3
+
 char addr_str[INET6_ADDRSTRLEN];
 struct sockaddr_storage dest;
 
@@ -194,285 +209,329 @@ static void resolve_addr(char *host, int family, int type, int proto, void *sock
   freeaddrinfo(info);
 }
 
+static unsigned long long usec_now(void)
+{
+  struct timeval tv;
+
+  gettimeofday(&tv, NULL);
+
+  return tv.tv_sec*USEC+tv.tv_usec;
+}
+
+// Work out which probe the ICMP reply in toybuf answers. Returns its seq with
+// the result filled in, or 0 if it isn't one of ours.
+static unsigned parse_reply4(int rcv_len, struct probe *pr)
+{
+  struct ip *rcv_pkt = (struct ip*) toybuf;
+  struct icmp *ricmp;
+  struct ip *hip;
+  unsigned seq = 0;
+
+  ricmp = (struct icmp *) ((char*)rcv_pkt + (rcv_pkt->ip_hl << 2));
+  if (ricmp->icmp_code == ICMP_UNREACH_NEEDFRAG)
+    pr->pmtu = ntohs(ricmp->icmp_nextmtu);
+
+  if (!((ricmp->icmp_type == ICMP_TIMXCEED
+        && ricmp->icmp_code == ICMP_TIMXCEED_INTRANS)
+      || ricmp->icmp_type == ICMP_UNREACH
+      || ricmp->icmp_type == ICMP_ECHOREPLY)) return 0;
+
+  hip = &ricmp->icmp_ip;
+  if (toys.optflags & FLAG_U) {
+    struct udphdr *hudp = (struct udphdr*) ((char*)hip + (hip->ip_hl << 2));
+
+    if ((hip->ip_hl << 2) + 12 <=(rcv_len - (rcv_pkt->ip_hl << 2))
+        && hip->ip_p == IPPROTO_UDP) {
+      seq = (uint16_t)(hudp->dest - TT.port);
+      pr->res = (ricmp->icmp_type == ICMP_TIMXCEED ? -1 : ricmp->icmp_code);
+    }
+  } else {
+    struct icmp *hicmp = (struct icmp *) ((char*)hip + (hip->ip_hl << 2));
+
+    if (ricmp->icmp_type == ICMP_ECHOREPLY
+        && ricmp->icmp_id == ntohs(TT.ident)) {
+      seq = ntohs(ricmp->icmp_seq);
+      pr->res = ICMP_UNREACH_PORT;
+    } else if ((hip->ip_hl << 2) + ICMP_HD_SIZE4
+        <= (rcv_len - (rcv_pkt->ip_hl << 2))
+        && hip->ip_p == IPPROTO_ICMP
+        && hicmp->icmp_id == htons(TT.ident)) {
+      seq = ntohs(hicmp->icmp_seq);
+      pr->res = (ricmp->icmp_type == ICMP_TIMXCEED ? -1 : ricmp->icmp_code);
+    }
+  }
+  pr->ttl = rcv_pkt->ip_ttl;
+  pr->type = ricmp->icmp_type;
+  pr->code = ricmp->icmp_code;
+
+  return pr->res ? seq : 0;
+}
+
+static unsigned parse_reply6(int rcv_len, struct probe *pr)
+{
+  struct icmp6_hdr *ricmp  = (struct icmp6_hdr *) toybuf;
+  struct ip6_hdr *hip;
+  struct udphdr *hudp;
+  struct payload_s *pkt;
+  int hdr_next;
+
+  if (!((ricmp->icmp6_type == ICMP6_TIME_EXCEEDED
+        && ricmp->icmp6_code == ICMP6_TIME_EXCEED_TRANSIT)
+      || ricmp->icmp6_type == ICMP6_DST_UNREACH
+      || ricmp->icmp6_type == ICMP6_ECHO_REPLY)) return 0;
+
+  hip = (struct ip6_hdr *)(ricmp + 1);
+  hudp = (struct udphdr*) (hip + 1);
+  hdr_next = hip->ip6_nxt;
+  if (hdr_next == IPPROTO_FRAGMENT) {
+    hdr_next = *(unsigned char*)hudp;
+    hudp++;
+  }
+  if (hdr_next != IPPROTO_UDP) return 0;
+
+  pkt = (struct payload_s*)(hudp + 1);
+  if (pkt->ident != TT.ident) return 0;
+  pr->res = (ricmp->icmp6_type == ICMP6_TIME_EXCEEDED) ? -1 : ricmp->icmp6_code;
+
+  return pkt->seq;
+}
+
+// Print one probe's part of its TTL's line. Returns 1 for each probe that
+// counts towards giving up on the trace.
+static int print_probe4(struct probe *pr, struct sockaddr_storage *last_addr,
+  int *dest_reach)
+{
+  struct sockaddr_in *from = &pr->from.in;
+
+  if (memcmp(&((struct sockaddr_in *)last_addr)->sin_addr,
+        &from->sin_addr, sizeof(struct in_addr))) {
+    if (!(toys.optflags & FLAG_n)) {
+      char host[NI_MAXHOST];
+      if (!getnameinfo((struct sockaddr *) from,
+            sizeof(struct sockaddr_in), host, NI_MAXHOST, NULL, 0, 0))
+        xprintf("  %s (", host);
+      else xprintf(" %s (", inet_ntoa(from->sin_addr));
+    }
+    xprintf(" %s", inet_ntoa(from->sin_addr));
+    if (!(toys.optflags & FLAG_n)) xprintf(")");
+    memcpy(last_addr, from, sizeof(*from));
+  }
+  xprintf("  %u.%03u ms", pr->delta / 1000, pr->delta % 1000);
+  if (toys.optflags & FLAG_l) xprintf(" (%d)", pr->ttl);
+  if (toys.optflags & FLAG_v) {
+    xprintf(" %d bytes from %s : icmp type %d code %d\t",
+        pr->len, inet_ntoa(from->sin_addr), pr->type, pr->code);
+  }
+
+  switch (pr->res) {
+    case ICMP_UNREACH_PORT:
+      if (pr->ttl <= 1) xprintf(" !");
+      *dest_reach = 1;
+      break;
+    case ICMP_UNREACH_NET:
+      xprintf(" !N");
+      return 1;
+    case ICMP_UNREACH_HOST:
+      xprintf(" !H");
+      return 1;
+    case ICMP_UNREACH_PROTOCOL:
+      xprintf(" !P");
+      *dest_reach = 1;
+      break;
+    case ICMP_UNREACH_NEEDFRAG:
+      xprintf(" !F-%d", pr->pmtu);
+      return 1;
+    case ICMP_UNREACH_SRCFAIL:
+      xprintf(" !S");
+      return 1;
+    case ICMP_UNREACH_FILTER_PROHIB:
+    case ICMP_UNREACH_NET_PROHIB:
+      xprintf(" !A");
+      return 1;
+    case ICMP_UNREACH_HOST_PROHIB:
+      xprintf(" !C");
+      return 1;
+    case ICMP_UNREACH_HOST_PRECEDENCE:
+      xprintf(" !V");
+      return 1;
+    case ICMP_UNREACH_PRECEDENCE_CUTOFF:
+      xprintf(" !C");
+      return 1;
+    case ICMP_UNREACH_NET_UNKNOWN:
+    case ICMP_UNREACH_HOST_UNKNOWN:
+      xprintf(" !U");
+      return 1;
+    case ICMP_UNREACH_ISOLATED:
+      xprintf(" !I");
+      return 1;
+    case ICMP_UNREACH_TOSNET:
+    case ICMP_UNREACH_TOSHOST:
+      xprintf(" !T");
+      return 1;
+    default:
+      break;
+  }
+
+  return 0;
+}
+
+static int print_probe6(struct probe *pr, struct sockaddr_storage *last_addr,
+  int *dest_reach, int print_verbose)
+{
+  struct sockaddr_in6 *from = &pr->from.in6;
+
+  if (memcmp(&((struct sockaddr_in6 *)last_addr)->sin6_addr,
+        &from->sin6_addr, sizeof(struct in6_addr))) {
+    if (!(toys.optflags & FLAG_n)) {
+      char host[NI_MAXHOST];
+      if (!getnameinfo((struct sockaddr *) from,
+            sizeof(*from), host, sizeof(host), NULL, 0, 0))
+        xprintf("  %s (", host);
+    }
+    memset(addr_str, '\0', INET6_ADDRSTRLEN);
+    inet_ntop(AF_INET6, &from->sin6_addr, addr_str, INET6_ADDRSTRLEN);
+    xprintf(" %s", addr_str);
+
+    if (!(toys.optflags & FLAG_n)) xprintf(")");
+    memcpy(last_addr, from, sizeof(*from));
+  }
+
+  if ((toys.optflags & FLAG_v) && print_verbose) {
+    memset(addr_str, '\0', INET6_ADDRSTRLEN);
+    inet_ntop(AF_INET6, &from->sin6_addr, addr_str, INET6_ADDRSTRLEN);
+    xprintf(" %d bytes to %s ", pr->len - (int)sizeof(struct ip6_hdr),
+      addr_str);
+  }
+  xprintf("  %u.%03u ms", pr->delta / 1000, pr->delta % 1000);
+
+  switch (pr->res) {
+    case ICMP6_DST_UNREACH_NOPORT:
+      *dest_reach = 1;
+      return 1;
+    case ICMP6_DST_UNREACH_NOROUTE:
+      xprintf(" !N");
+      return 1;
+    case ICMP6_DST_UNREACH_ADDR:
+      xprintf(" !H");
+      return 1;
+    case ICMP6_DST_UNREACH_ADMIN:
+      xprintf(" !S");
+      return 1;
+    default:
+      break;
+  }
+
+  return 0;
+}
+
+// Keep up to -N probes in flight, in TTL order, and match replies back to
+// their probe by sequence number. Results are printed in order as soon as
+// every earlier probe is answered or timed out, so -N 1 sends a probe, waits
+// for it and prints it before moving on, the way traceroute always has.
 static void do_trace()
 {
-  int seq, fexit, ttl, tv = TT.wait_time * 1000;
+  int seq, fexit = 0, dest_reach = 0, print_verbose = 1, tv = TT.wait_time*1000,
+    total = (TT.max_ttl-TT.first_ttl+1)*TT.ttl_probes, sent = 0, shown = 0,
+    inflight = 0;
+  unsigned long long now, wait = tv*1000ULL;
+  struct probe *probes = xzalloc(total*sizeof(struct probe)), *pr, reply;
   struct pollfd pfd[1];
-  struct sockaddr_storage from;
+  struct sockaddr_storage last_addr, from;
 
   memset(&from, 0, sizeof(from));
   pfd[0].fd = TT.recv_sock;
   pfd[0].events = POLLIN;
 
-  for (ttl = TT.first_ttl; ttl <= TT.max_ttl; ++ttl) {
-    int probe, dest_reach = 0, print_verbose = 1;
-    struct timeval t1, t2;
-    struct sockaddr_storage last_addr;
+  for (;;) {
+    int tleft = tv;
 
-    memset(&last_addr, 0, sizeof(last_addr));
-    fexit = 0;
-    xprintf("%2d", ttl);
+    // Send as many probes as we're allowed in flight
+    while (sent < total && inflight < TT.inflight) {
+      if (!TT.istraceroute6 && (sent % TT.ttl_probes)
+          && (toys.optflags & FLAG_z)) usleep(TT.pause_time * 1000);
+      seq = ++sent;
+      if (!TT.istraceroute6)
+        send_probe4(seq, TT.first_ttl + (seq-1)/TT.ttl_probes);
+      else send_probe6(seq, TT.first_ttl + (seq-1)/TT.ttl_probes);
+      probes[seq-1].sent = usec_now();
+      probes[seq-1].state = PROBE_SENT;
+      inflight++;
+    }
 
-    for (probe = 0, seq = 0; probe < TT.ttl_probes; ++probe) {
-      int res = 0, tleft;
+    // Time out probes, and wait no longer than the oldest one has left
+    now = usec_now();
+    for (seq = shown; seq < sent; seq++) {
+      pr = probes+seq;
+      if (pr->state != PROBE_SENT) continue;
+      if (now - pr->sent >= wait) {
+        pr->state = PROBE_LOST;
+        inflight--;
+      } else if (tleft > (wait - (now - pr->sent) + 999)/1000)
+        tleft = (wait - (now - pr->sent) + 999)/1000;
+    }
 
-      fflush(NULL);
-      if (!TT.istraceroute6)
-        if (probe && (toys.optflags & FLAG_z)) usleep(TT.pause_time * 1000);
-
-      if (!TT.istraceroute6) send_probe4(++seq, ttl);
-      else send_probe6(++seq, ttl);
-      gettimeofday(&t1, NULL);
-      t2 = t1;
-
-      while ((tleft = (int)(tv - ((unsigned long long)(t2.tv_sec * 1000ULL 
-                  + t2.tv_usec/1000) - (unsigned long long)(t1.tv_sec * 1000ULL
-                    + t1.tv_usec/1000)))) >= 0) {
-        unsigned delta = 0;
-        if (!(res = poll(pfd, 1, tleft))) { 
-          xprintf("  *"); 
-          break;
-        }
-        gettimeofday(&t2, NULL);
-        if (res < 0) {
-          if (errno != EINTR) perror_exit("poll");
-          continue;
-        }
-        delta = (t2.tv_sec * USEC + t2.tv_usec)
-          - (t1.tv_sec * USEC + t1.tv_usec);
-
-        if (pfd[0].revents) {
-          socklen_t addrlen = sizeof(struct sockaddr_storage);
-          int rcv_len, icmp_res = 0;
-
-          rcv_len = recvfrom(TT.recv_sock, toybuf, sizeof(toybuf),
-              MSG_DONTWAIT, (struct sockaddr *) &from, &addrlen);
-          if (rcv_len <= 0) continue;
-
-          if (!TT.istraceroute6) {
-            int pmtu = 0;
-            struct ip *rcv_pkt = (struct ip*) toybuf;
-            struct icmp *ricmp;
-
-            ricmp = (struct icmp *) ((char*)rcv_pkt + (rcv_pkt->ip_hl << 2));
-            if (ricmp->icmp_code == ICMP_UNREACH_NEEDFRAG)
-              pmtu = ntohs(ricmp->icmp_nextmtu);
-
-            if ((ricmp->icmp_type == ICMP_TIMXCEED
-                  && ricmp->icmp_code == ICMP_TIMXCEED_INTRANS)
-                || ricmp->icmp_type == ICMP_UNREACH
-                || ricmp->icmp_type == ICMP_ECHOREPLY) {
-
-              struct udphdr *hudp;
-              struct icmp *hicmp;
-              struct ip *hip = &ricmp->icmp_ip;
-
-              if (toys.optflags & FLAG_U) {
-                hudp = (struct udphdr*) ((char*)hip + (hip->ip_hl << 2));
-                if ((hip->ip_hl << 2) + 12 <=(rcv_len - (rcv_pkt->ip_hl << 2))
-                    && hip->ip_p == IPPROTO_UDP
-                    && hudp->dest == (TT.port + seq))
-                  icmp_res = (ricmp->icmp_type == ICMP_TIMXCEED ? -1 :
-                      ricmp->icmp_code);
-              } else {
-                hicmp = (struct icmp *) ((char*)hip + (hip->ip_hl << 2));
-                if (ricmp->icmp_type == ICMP_ECHOREPLY 
-                    && ricmp->icmp_id == ntohs(TT.ident)
-                    && ricmp->icmp_seq == ntohs(seq))
-                  icmp_res = ICMP_UNREACH_PORT;
-                else if ((hip->ip_hl << 2) + ICMP_HD_SIZE4 
-                    <= (rcv_len - (rcv_pkt->ip_hl << 2))
-                    && hip->ip_p == IPPROTO_ICMP
-                    && hicmp->icmp_id == htons(TT.ident)
-                    && hicmp->icmp_seq == htons(seq))
-                  icmp_res = (ricmp->icmp_type == ICMP_TIMXCEED ? -1 : 
-                      ricmp->icmp_code);
-              }
-            }
-            if (!icmp_res) continue;
-
-            if (addrlen > 0) {
-              if (memcmp(&((struct sockaddr_in *)&last_addr)->sin_addr, 
-                    &((struct sockaddr_in *)&from)->sin_addr, 
-                    sizeof(struct in_addr))) {
-                if (!(toys.optflags & FLAG_n)) {
-                  char host[NI_MAXHOST];
-                  if (!getnameinfo((struct sockaddr *) &from, 
-                        sizeof(struct sockaddr_in), host, NI_MAXHOST, NULL, 0, 0))
-                    xprintf("  %s (", host);
-                  else xprintf(" %s (", inet_ntoa(
-                          ((struct sockaddr_in *)&from)->sin_addr));
-                }
-                xprintf(" %s", inet_ntoa(
-                      ((struct sockaddr_in *)&from)->sin_addr));
-                if (!(toys.optflags & FLAG_n)) xprintf(")");
-                memcpy(&last_addr, &from, sizeof(from));
-              }
-              xprintf("  %u.%03u ms", delta / 1000, delta % 1000);
-              if (toys.optflags & FLAG_l) xprintf(" (%d)", rcv_pkt->ip_ttl);
-              if (toys.optflags & FLAG_v) {
-                xprintf(" %d bytes from %s : icmp type %d code %d\t",
-                    rcv_len, inet_ntoa(((struct sockaddr_in *)&from)->sin_addr),
-                    ricmp->icmp_type, ricmp->icmp_code);
-              }
-            } else xprintf("\t!H");
-
-            switch (icmp_res) {
-              case ICMP_UNREACH_PORT:
-                if (rcv_pkt->ip_ttl <= 1) xprintf(" !");
-                dest_reach = 1;
-                break;
-              case ICMP_UNREACH_NET:
-                xprintf(" !N");
-                ++fexit;
-                break;
-              case ICMP_UNREACH_HOST:
-                xprintf(" !H");
-                ++fexit;
-                break;
-              case ICMP_UNREACH_PROTOCOL:
-                xprintf(" !P");
-                dest_reach = 1;
-                break;
-              case ICMP_UNREACH_NEEDFRAG:
-                xprintf(" !F-%d", pmtu);
-                ++fexit;
-                break;
-              case ICMP_UNREACH_SRCFAIL:
-                xprintf(" !S");
-                ++fexit;
-                break;
-              case ICMP_UNREACH_FILTER_PROHIB:
-              case ICMP_UNREACH_NET_PROHIB:
-                xprintf(" !A");
-                ++fexit;
-                break;
-              case ICMP_UNREACH_HOST_PROHIB:
-                xprintf(" !C");
-                ++fexit;
-                break;
-              case ICMP_UNREACH_HOST_PRECEDENCE:
-                xprintf(" !V");
-                ++fexit;
-                break;
-              case ICMP_UNREACH_PRECEDENCE_CUTOFF:
-                xprintf(" !C");
-                ++fexit;
-                break;
-              case ICMP_UNREACH_NET_UNKNOWN:  
-              case ICMP_UNREACH_HOST_UNKNOWN:
-                xprintf(" !U");
-                ++fexit;
-                break;
-              case ICMP_UNREACH_ISOLATED:
-                xprintf(" !I");
-                ++fexit;
-                break;
-              case ICMP_UNREACH_TOSNET:
-              case ICMP_UNREACH_TOSHOST:
-                xprintf(" !T");
-                ++fexit;
-                break;
-              default:
-                break;
-            }
-            break;
-          } else {
-            struct icmp6_hdr *ricmp  = (struct icmp6_hdr *) toybuf;
-
-            if ((ricmp->icmp6_type == ICMP6_TIME_EXCEEDED
-                  && ricmp->icmp6_code == ICMP6_TIME_EXCEED_TRANSIT)
-                || ricmp->icmp6_type == ICMP6_DST_UNREACH
-                || ricmp->icmp6_type == ICMP6_ECHO_REPLY) {
-
-              struct ip6_hdr *hip;
-              struct udphdr *hudp;
-              int hdr_next;
-
-              hip = (struct ip6_hdr *)(ricmp + 1);
-              hudp = (struct udphdr*) (hip + 1);
-              hdr_next = hip->ip6_nxt;
-              if (hdr_next == IPPROTO_FRAGMENT) {
-                hdr_next = *(unsigned char*)hudp;
-                hudp++;
-              }
-
-              if (hdr_next == IPPROTO_UDP) {
-                struct payload_s *pkt = (struct payload_s*)(hudp + 1);
-                if ((pkt->ident == TT.ident) && (pkt->seq == seq))
-                  icmp_res = (ricmp->icmp6_type == ICMP6_TIME_EXCEEDED) ? -1 :
-                    ricmp->icmp6_code;
-              }
-            }
-
-            if (!icmp_res) continue;
-            if (addrlen > 0) {
-              if (memcmp(&((struct sockaddr_in6 *)&last_addr)->sin6_addr, 
-                    &((struct sockaddr_in6 *)&from)->sin6_addr, 
-                    sizeof(struct in6_addr))) {
-                if (!(toys.optflags & FLAG_n)) {
-                  char host[NI_MAXHOST];
-                  if (!getnameinfo((struct sockaddr *) &from,
-                        sizeof(from), host, sizeof(host), NULL, 0, 0))
-                    xprintf("  %s (", host);
-                }
-                memset(addr_str, '\0', INET6_ADDRSTRLEN);
-                inet_ntop(AF_INET6, &((struct sockaddr_in6 *)&from)->sin6_addr,
-                    addr_str, INET6_ADDRSTRLEN);
-                xprintf(" %s", addr_str);
-
-                if (!(toys.optflags & FLAG_n)) xprintf(")");
-                memcpy(&last_addr,&from,sizeof(from));
-              }
-
-              if (toys.optflags & FLAG_v) {
-                if(print_verbose){
-                  memset(addr_str, '\0', INET6_ADDRSTRLEN);
-                  inet_ntop(AF_INET6, &((struct sockaddr_in6 *)
-                        &from)->sin6_addr, addr_str, INET6_ADDRSTRLEN);
-                  rcv_len -= sizeof(struct ip6_hdr);
-                  xprintf(" %d bytes to %s ", rcv_len, addr_str);
-                }
-              }
-              xprintf("  %u.%03u ms", delta / 1000, delta % 1000);
-              delta = 0;
-
-            } else xprintf("\t!H");
-
-            switch (icmp_res) {
-              case ICMP6_DST_UNREACH_NOPORT:
-                ++fexit;
-                dest_reach = 1;
-                break;
-              case ICMP6_DST_UNREACH_NOROUTE:
-                xprintf(" !N");
-                ++fexit;
-                break;
-              case ICMP6_DST_UNREACH_ADDR:
-                xprintf(" !H");
-                ++fexit;
-                break;
-              case ICMP6_DST_UNREACH_ADMIN:
-                xprintf(" !S");
-                ++fexit;
-                break;
-              default:
-                break;
-            }
-            break;
-          }
-        } //revents
+    // Print everything that's been answered, in order
+    for (; shown < sent && probes[shown].state >= PROBE_GOT; shown++) {
+      int probe = shown % TT.ttl_probes;
+
+      pr = probes+shown;
+      if (!probe) {
+        memset(&last_addr, 0, sizeof(last_addr));
+        fexit = dest_reach = 0;
+        print_verbose = 1;
+        xprintf("%2ld", TT.first_ttl + shown/TT.ttl_probes);
+      }
+      if (pr->state == PROBE_LOST) xprintf("  *");
+      else {
+        memcpy(&from, &pr->from, sizeof(pr->from));
+        if (!TT.istraceroute6)
+          fexit += print_probe4(pr, &last_addr, &dest_reach);
+        else fexit += print_probe6(pr, &last_addr, &dest_reach, print_verbose);
       }
       print_verbose = 0;
+      if (probe != TT.ttl_probes-1) continue;
+
+      xputc('\n');
+      if(!TT.istraceroute6) {
+        if (!memcmp(&((struct sockaddr_in *)&from)->sin_addr,
+              &((struct sockaddr_in *)&dest)->sin_addr, sizeof(struct in_addr))
+            || dest_reach || (fexit && fexit >= TT.ttl_probes -1))
+          goto done;
+      } else if (dest_reach || (fexit > 0 && fexit >= TT.ttl_probes -1))
+        goto done;
+    }
+    if (shown == total) break;
+    fflush(NULL);
+
+    // If there's room to send more, go do that now
+    if (sent < total && inflight < TT.inflight) continue;
+    if (!poll(pfd, 1, tleft)) continue;
+
+    // Collect every reply that has arrived
+    for (;;) {
+      socklen_t addrlen = sizeof(reply.from);
+      int rcv_len;
+
+      memset(&reply, 0, sizeof(reply));
+      rcv_len = recvfrom(TT.recv_sock, toybuf, sizeof(toybuf),
+          MSG_DONTWAIT, (struct sockaddr *) &reply.from, &addrlen);
+      if (rcv_len <= 0) break;
+
+      seq = TT.istraceroute6 ? parse_reply6(rcv_len, &reply)
+        : parse_reply4(rcv_len, &reply);
+      if (seq < 1 || seq > sent || probes[seq-1].state != PROBE_SENT) continue;
+      pr = probes+seq-1;
+      reply.len = rcv_len;
+      reply.sent = pr->sent;
+      reply.delta = usec_now() - pr->sent;
+      reply.state = PROBE_GOT;
+      *pr = reply;
+      inflight--;
     }
-    xputc('\n');
-    if(!TT.istraceroute6) {
-      if (!memcmp(&((struct sockaddr_in *)&from)->sin_addr, 
-            &((struct sockaddr_in *)&dest)->sin_addr, sizeof(struct in_addr))
-          || dest_reach || (fexit && fexit >= TT.ttl_probes -1))
-        break;
-    } else if (dest_reach || (fexit > 0 && fexit >= TT.ttl_probes -1)) break;
   }
+
+done:
+  if (CFG_TOYBOX_FREE) free(probes);
 }
 
 void traceroute_main(void)
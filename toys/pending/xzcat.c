@@ -190,8 +190,9 @@ static uint64_t xz_crc64_table[256];
 
 // END xz.h
 
-static uint8_t in[BUFSIZ];
-static uint8_t out[BUFSIZ];
+// Big buffers so we don't enter and exit xz_dec_run() every few kilobytes
+static uint8_t in[1<<16];
+static uint8_t out[1<<17];
 
 void do_xzcat(int fd, char *name)
 {
@@ -230,7 +231,7 @@ void do_xzcat(int fd, char *name)
   b.in_size = 0;
   b.out = out;
   b.out_pos = 0;
-  b.out_size = BUFSIZ;
+  b.out_size = sizeof(out);
 
   for (;;) {
     if (b.in_pos == b.in_size) {
@@ -319,6 +320,13 @@ void xzcat_main(void)
 
 #define memeq(a, b, size) (memcmp(a, b, size) == 0)
 
+/* toybox builds with -Os, which won't inline the per-bit range decoder. */
+#ifdef __GNUC__
+#define ALWAYS_INLINE __attribute__((always_inline))
+#else
+#define ALWAYS_INLINE
+#endif
+
 /* Inline functions to access unaligned unsigned 32-bit integers */
 #ifndef get_unaligned_le32
 static inline uint32_t get_unaligned_le32(const uint8_t *buf)
@@ -1617,7 +1625,7 @@ static inline int rc_is_finished(const struct rc_dec *rc)
 }
 
 /* Read the next input byte if needed. */
-static inline void rc_normalize(struct rc_dec *rc)
+static inline ALWAYS_INLINE void rc_normalize(struct rc_dec *rc)
 {
   if (rc->range < RC_TOP_VALUE) {
     rc->range <<= RC_SHIFT_BITS;
@@ -1636,7 +1644,7 @@ static inline void rc_normalize(struct rc_dec *rc)
  * of the code generated by GCC 3.x decreases 10-15 %. (GCC 4.3 doesn't care,
  * and it generates 10-20 % faster code than GCC 3.x from this file anyway.)
  */
-static inline int rc_bit(struct rc_dec *rc, uint16_t *prob)
+static inline ALWAYS_INLINE int rc_bit(struct rc_dec *rc, uint16_t *prob)
 {
   uint32_t bound;
   int bit;
@@ -1657,18 +1665,39 @@ static inline int rc_bit(struct rc_dec *rc, uint16_t *prob)
   return bit;
 }
 
-/* Decode a bittree starting from the most significant bit. */
+/*
+ * Decode a bittree starting from the most significant bit. This is most of
+ * the literal decoding time, so it's rc_bit() unrolled with the range decoder
+ * state in locals. (We build with -fno-strict-aliasing, so every store to
+ * probs[] would otherwise force rc->range and rc->code to be reloaded.)
+ */
 static inline uint32_t rc_bittree(struct rc_dec *rc,
              uint16_t *probs, uint32_t limit)
 {
-  uint32_t symbol = 1;
+  uint32_t symbol = 1, range = rc->range, code = rc->code, bound;
+  const uint8_t *in = rc->in;
+  size_t in_pos = rc->in_pos;
 
   do {
-    if (rc_bit(rc, &probs[symbol]))
-      symbol = (symbol << 1) + 1;
-    else
+    if (range < RC_TOP_VALUE) {
+      range <<= RC_SHIFT_BITS;
+      code = (code << RC_SHIFT_BITS) + in[in_pos++];
+    }
+    bound = (range >> RC_BIT_MODEL_TOTAL_BITS) * probs[symbol];
+    if (code < bound) {
+      range = bound;
+      probs[symbol] += (RC_BIT_MODEL_TOTAL - probs[symbol]) >> RC_MOVE_BITS;
       symbol <<= 1;
+    } else {
+      range -= bound;
+      code -= bound;
+      probs[symbol] -= probs[symbol] >> RC_MOVE_BITS;
+      symbol = (symbol << 1) + 1;
+    }
   } while (symbol < limit);
+  rc->range = range;
+  rc->code = code;
+  rc->in_pos = in_pos;
 
   return symbol;
 }
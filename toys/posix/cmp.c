@@ -24,13 +24,48 @@ config CMP
 GLOBALS(
   int fd;
   char *name;
+
+  char *buf;
+  int outlen;
 )
 
+#define CMP_BUF 65536
+
+// Return offset of first difference, or len if none. Let libc's memcmp
+// (which is vectorized) skip the identical parts.
+static int mismatch(char *a, char *b, int len)
+{
+  int i = 0;
+
+  if (!memcmp(a, b, len)) return len;
+  while (i+64 <= len && !memcmp(a+i, b+i, 64)) i += 64;
+  while (i<len && a[i] == b[i]) i++;
+
+  return i;
+}
+
+static long count_lines(char *s, int len)
+{
+  char *end = s+len;
+  long lines = 0;
+
+  while ((s = memchr(s, '\n', end-s))) lines++, s++;
+
+  return lines;
+}
+
+// -l output can be one line per byte, so batch it instead of a write each.
+static void flush_l(void)
+{
+  xwrite(1, toybuf, TT.outlen);
+  TT.outlen = 0;
+}
+
 static void do_cmp(int fd, char *name)
 {
-  int i, len1, len2, min_len, size = sizeof(toybuf)/2;
-  long byte_no = 1, line_no = 1;
-  char *buf2 = toybuf+size;
+  int i, len1, len2, min_len;
+  long long byte_no = 1, line_no = 1;
+  char *buf1, *buf2;
 
   // First time through, cache the data and return.
   if (!TT.fd) {
@@ -38,32 +73,38 @@ static void do_cmp(int fd, char *name)
     // On return the old filehandle is closed, and this assures that even
     // if we were called with stdin closed, the new filehandle != 0.
     TT.fd = dup(fd);
+    TT.buf = xmalloc(2*CMP_BUF);
     return;
   }
+  buf1 = TT.buf;
+  buf2 = TT.buf+CMP_BUF;
 
   toys.exitval = 0;
 
   for (;;) {
-    len1 = readall(TT.fd, toybuf, size);
-    len2 = readall(fd, buf2, size);
-
-    min_len = len1 < len2 ? len1 : len2;
-    for (i=0; i<min_len; i++) {
-      if (toybuf[i] != buf2[i]) {
-        toys.exitval = 1;
-        if (toys.optflags & FLAG_l)
-          printf("%ld %o %o\n", byte_no, toybuf[i], buf2[i]);
-        else {
-          if (!(toys.optflags & FLAG_s)) 
-            printf("%s %s differ: char %ld, line %ld\n",
-              TT.name, name, byte_no, line_no);
-          goto out;
-        }
+    len1 = readall(TT.fd, buf1, CMP_BUF);
+    len2 = readall(fd, buf2, CMP_BUF);
+
+    // A read error (say on a directory) counts as EOF
+    if ((min_len = len1 < len2 ? len1 : len2) < 0) min_len = 0;
+    for (i = 0; (i += mismatch(buf1+i, buf2+i, min_len-i)) < min_len; i++) {
+      toys.exitval = 1;
+      if (toys.optflags & FLAG_l) {
+        if (TT.outlen > sizeof(toybuf)-64) flush_l();
+        TT.outlen += sprintf(toybuf+TT.outlen, "%lld %o %o\n", byte_no+i,
+          (unsigned char)buf1[i], (unsigned char)buf2[i]);
+      } else {
+        if (!(toys.optflags & FLAG_s))
+          printf("%s %s differ: char %lld, line %lld\n",
+            TT.name, name, byte_no+i, line_no+count_lines(buf1, i));
+        goto out;
       }
-      byte_no++;
-      if (toybuf[i] == '\n') line_no++;
     }
+    byte_no += min_len;
+    if (!(toys.optflags & (FLAG_l|FLAG_s)))
+      line_no += count_lines(buf1, min_len);
     if (len1 != len2) {
+      if (TT.outlen) flush_l();
       if (!(toys.optflags & FLAG_s))
         fprintf(stderr, "cmp: EOF on %s\n", len1 < len2 ? TT.name : name);
       toys.exitval = 1;
@@ -72,7 +113,11 @@ static void do_cmp(int fd, char *name)
     if (len1 < 1) break;
   }
 out:
-  if (CFG_TOYBOX_FREE) close(TT.fd);
+  if (TT.outlen) flush_l();
+  if (CFG_TOYBOX_FREE) {
+    close(TT.fd);
+    free(TT.buf);
+  }
 }
 
 void cmp_main(void)
@@ -29,7 +29,7 @@ config CPIO
 
     -F FILE	Use archive FILE instead of stdin/stdout
     -p DEST	Copy-pass mode, copy stdin file list to directory DEST
-    -i	Extract from archive into file system (stdin=archive)
+    -i	Extract from archive into file system (stdin=archive, gz/bz2/xz ok)
     -o	Create archive (stdin=list of files, stdout=archive)
     -t	Test files (list only, stdin=archive, stdout=list of files)
     -v	Verbose
@@ -81,7 +81,7 @@ void cpio_main(void)
 {
   // Subtle bit: FLAG_o is 1 so we can just use it to select stdin/stdout.
   int pipe, afd = toys.optflags & FLAG_o;
-  pid_t pid = 0;
+  pid_t pid = 0, zpid = 0;
 
   // In passthrough mode, parent stays in original dir and generates archive
   // to pipe, child does chdir to new dir and reads archive from stdin (pipe).
@@ -104,6 +104,19 @@ void cpio_main(void)
     afd = xcreate(TT.F, perm, 0644);
   }
 
+  // Decompress seekable gzip/bzip2/xz archives through a child process
+  if ((toys.optflags & (FLAG_i|FLAG_t)) && !lseek(afd, 0, SEEK_CUR)) {
+    int len = readall(afd, toybuf, 7), pipefd[2] = {afd, -1};
+    char *cat = compression_cat(toybuf, len);
+
+    if (len>0 && lseek(afd, 0, SEEK_SET)) perror_exit("lseek");
+    if (cat) {
+      zpid = xpopen_cat(cat, pipefd);
+      if (afd) close(afd);
+      afd = pipefd[1];
+    }
+  }
+
   // read cpio archive
 
   if (toys.optflags & (FLAG_i|FLAG_t)) for (;;) {
@@ -280,7 +293,8 @@ void cpio_main(void)
         sprintf(toybuf, "070701%040X%056X%08XTRAILER!!!", 1, 0x0b, 0)+4);
     }
   }
-  if (TT.F) xclose(afd);
+  if (TT.F || zpid) xclose(afd);
+  if (zpid) toys.exitval |= xwaitpid(zpid);
 
   if (TT.p) toys.exitval |= xpclose(pid, pipe);
 }
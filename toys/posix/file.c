@@ -206,7 +206,7 @@ bad:
 
 static void do_regular_file(int fd, char *name)
 {
-  char *s;
+  char *s, *cat;
   int len, magic;
 
   // zero through elf shnum, just in case
@@ -280,12 +280,12 @@ static void do_regular_file(int fd, char *name)
     xprintf("Zip archive data");
     if (ver) xprintf(", requires at least v%d.%d to extract", ver/10, ver%10);
     xputc('\n');
-  } else if (len>4 && strstart(&s, "BZh") && isdigit(*s))
-    xprintf("bzip2 compressed data, block size = %c00k\n", *s);
-  else if (len > 31 && peek_be(s, 7) == 0xfd377a585a0000)
-    xprintf("xz compressed data");
-  else if (len>10 && strstart(&s, "\x1f\x8b")) xputs("gzip compressed data");
-  else if (len>32 && !memcmp(s+1, "\xfa\xed\xfe", 3)) {
+  } else if ((cat = compression_cat(s, len)) && (*cat!='b' || isdigit(s[3]))) {
+    // Same magic bytes tar and cpio use to pick a decompressor
+    if (*cat == 'b')
+      xprintf("bzip2 compressed data, block size = %c00k\n", s[3]);
+    else xprintf("%s compressed data\n", *cat=='z' ? "gzip" : "xz");
+  } else if (len>32 && !memcmp(s+1, "\xfa\xed\xfe", 3)) {
     int bit = s[0]=='\xce'?32:64;
     char *what;
 
@@ -38,16 +38,38 @@ GLOBALS(
   char *buf; // Points to buffers[0] or buffers[1].
   char *bufs[2]; // Used to detect duplicate lines.
   off_t pos;
+  char *out;
+  int outlen;
 )
 
+#define OD_OUT 65536
+
 static char *ascii = "nulsohstxetxeotenqackbel bs ht nl vt ff cr so si"
   "dledc1dc2dc3dc4naksynetbcan emsubesc fs gs rs us sp";
 
 struct odtype {
   int type;
   int size;
+  int width;
 };
 
+static void od_flush(void)
+{
+  xwrite(1, TT.out, TT.outlen);
+  TT.outlen = 0;
+}
+
+// Queue len bytes of s for output, right justified in a field of width.
+static void od_put(char *s, int len, int width)
+{
+  if (width<len) width = len;
+  if (TT.outlen+width>OD_OUT) od_flush();
+  memset(TT.out+TT.outlen, ' ', width-len);
+  memcpy(TT.out+TT.outlen+width-len, s, len);
+  TT.outlen += width;
+}
+
+// Write the next unit of TT.buf into buf, returning its padded width
 static int od_out_t(struct odtype *t, char *buf, int *offset)
 {
   unsigned k;
@@ -93,31 +115,33 @@ static int od_out_t(struct odtype *t, char *buf, int *offset)
   // Integer types
   } else {
     unsigned long long ll = 0, or;
-    char *c[] = {"%*lld", "%*llu", "%0*llo", "%0*llx"},
-      *class = c[t->type-2];
-
-    // Work out width of field
-    if (t->size == 8) {
-      or = -1LL;
-      if (t->type == 2) or >>= 1;
-    } else or = (1LL<<(8*t->size))-1;
-    throw = sprintf(buf, class, 0, or);
+    char *s = buf+24;
+    int neg = 0;
 
     // Accumulate integer based on size argument
     for (k=0; k < t->size; k++) {
-      or = TT.buf[(*offset)++];
+      or = (unsigned char)TT.buf[(*offset)++];
       ll |= or << (8*(IS_BIG_ENDIAN ? t->size-k-1 : k));
     }
 
     // Handle negative values
+    throw = t->width;
     if (t->type == 2) {
-      or = sizeof(or) - t->size;
       throw++;
-      if (or && (ll & (1l<<((8*t->size)-1))))
-        ll |= ((or<<(8*or))-1) << (8*t->size);
+      if (ll & (1ULL<<((8*t->size)-1))) {
+        ll = -(ll | (-1ULL << (8*t->size-1)));
+        neg++;
+      }
     }
 
-    sprintf(buf, class, throw, ll);
+    // Convert digits backwards, zero padding octal and hex to full width
+    *s = 0;
+    if (t->type == 4) do *--s = '0'+(ll&7); while (ll >>= 3);
+    else if (t->type == 5) do *--s = "0123456789abcdef"[ll&15]; while (ll >>= 4);
+    else do *--s = '0'+ll%10; while (ll /= 10);
+    if (t->type > 3) while (s>buf+24-throw) *--s = '0';
+    if (neg) *--s = '-';
+    memmove(buf, s, buf+25-s);
     pad += throw+1;
   }
 
@@ -138,7 +162,7 @@ static void od_outline(void)
     && !memcmp(TT.bufs[0], TT.bufs[1], TT.w))
   {
     if (!TT.star) {
-      xputs("*");
+      od_put("*\n", 2, 0);
       TT.star++;
     }
 
@@ -147,9 +171,9 @@ static void od_outline(void)
     TT.star = 0;
 
     // off_t varies so expand it to largest possible size
-    xprintf(abases[TT.address_idx], (long long)TT.pos);
+    od_put(buf, sprintf(buf, abases[TT.address_idx], (long long)TT.pos), 0);
     if (!TT.leftover) {
-      if (TT.address_idx) xputc('\n');
+      if (TT.address_idx) od_put("\n", 1, 0);
       return;
     }
   }
@@ -176,10 +200,10 @@ static void od_outline(void)
 
       // pad for as many bytes as were consumed, and indent non-numbered lines
       od_out_t(types+i, buf, &bytes);
-      xprintf("%*s", pad*(bytes-j) + 7*(!!i)*!j, buf);
+      od_put(buf, strlen(buf), pad*(bytes-j) + 7*(!!i)*!j);
       j = bytes;
     }
-    xputc('\n');
+    od_put("\n", 1, 0);
   }
 
   // Toggle buffer for "same as last time" check.
@@ -208,6 +232,7 @@ static void do_od(int fd, char *name)
 
     len = readall(fd, buf, len);
     if (len < 0) {
+      od_flush();
       perror_msg_raw(name);
       break;
     }
@@ -255,6 +280,16 @@ static void append_base(char *base)
 
     types[TT.types].type = type;
     types[TT.types].size = size;
+
+    // Work out width of integer fields
+    if (type > 1 && type < 6) {
+      unsigned long long or = -1LL;
+      char *c[] = {"%lld", "%llu", "%llo", "%llx"}, num[32];
+
+      if (size < 8) or = (1LL<<(8*size))-1;
+      else if (type == 2) or >>= 1;
+      types[TT.types].width = sprintf(num, c[type-2], or);
+    }
     TT.types++;
   }
 
@@ -268,6 +303,7 @@ void od_main(void)
   TT.bufs[0] = xzalloc(TT.w);
   TT.bufs[1] = xzalloc(TT.w);
   TT.buf = TT.bufs[0];
+  TT.out = xmalloc(OD_OUT);
 
   if (!TT.A) TT.address_idx = 2;
   else if (0>(TT.address_idx = stridx("ndox", *TT.A)))
@@ -288,9 +324,11 @@ void od_main(void)
 
   if (TT.leftover) od_outline();
   od_outline();
+  od_flush();
 
   if (CFG_TOYBOX_FREE) {
     free(TT.bufs[0]);
     free(TT.bufs[1]);
+    free(TT.out);
   }
 }
@@ -58,6 +58,10 @@ GLOBALS(
   long long *sparse;
   time_t mtt;
 
+  // Most recent user and group name lookups
+  char *idname[2];
+  int id[2];
+
   // hardlinks seen so far (hlc many)
   struct {
     char *arg;
@@ -299,19 +303,23 @@ static int add_to_tar(struct dirtree *node)
 
       return 0;
     }
-    if (FLAG(S)) {
+    // A file using at least as many blocks as its length can't have holes
+    if (FLAG(S) && st->st_blocks*512LL < st->st_size) {
       long long lo, ld = 0, len = 0;
 
-      // Enumerate the extents
-      while ((lo = lseek(fd, ld, SEEK_HOLE)) != -1) {
+      // Enumerate the extents. Running off the end (or no SEEK_HOLE support)
+      // means the rest of the file is data, or a trailing hole.
+      for (;;) {
+        if (ld>=st->st_size || -1 == (lo = lseek(fd, ld, SEEK_HOLE)))
+          lo = st->st_size;
         if (!(TT.sparselen&511))
           TT.sparse = xrealloc(TT.sparse, (TT.sparselen+514)*sizeof(long long));
-        if (ld != lo) {
+        if (ld < lo) {
           TT.sparse[TT.sparselen++] = ld;
           len += TT.sparse[TT.sparselen++] = lo-ld;
         }
         if (lo == st->st_size) {
-          if (TT.sparselen<=2) TT.sparselen = 0;
+          if (len == st->st_size) TT.sparselen = 0;
           else {
             // Gratuitous extra entry for compatibility with other versions
             TT.sparse[TT.sparselen++] = lo;
@@ -430,28 +438,30 @@ static int dirflush(char *name)
 // write data to file
 static void sendfile_sparse(int fd)
 {
-  long long len, used = 0, sent;
+  long long len, used = 0, sent = 0, pos = 0;
   int i = 0, j;
 
   do {
     if (TT.sparselen) {
-      if (!TT.sparse[i*2+1]) continue;
       // Seek past holes or fill output with zeroes.
       if (-1 == lseek(fd, len = TT.sparse[i*2], SEEK_SET)) {
-        sent = 0;
-        while (len) {
+        for (len -= pos; len>0; len -= j) {
           // first/last 512 bytes used, rest left zeroes
           j = (len>3072) ? 3072 : len;
           if (j != writeall(fd, toybuf+512, j)) goto error;
-          len -= j;
         }
-      }
+
+      // Trailing hole sets file length
+      } else if (i+1 == TT.sparselen && !TT.sparse[i*2+1] && ftruncate(fd, len))
+        goto error;
+      pos = TT.sparse[i*2];
       len = TT.sparse[i*2+1];
       if (len+used>TT.hdr.size) error_exit("sparse overflow");
     } else len = TT.hdr.size;
 
     len -= sendfile_len(TT.fd, fd, len, &sent);
     used += sent;
+    pos += sent;
     if (len) {
 error:
       if (fd!=1) perror_msg(0);
@@ -460,14 +470,50 @@ error:
       break;
     }
   } while (++i<TT.sparselen);
+}
 
-  close(fd);
+// Create filesystem entry for current header, returning open fd for regular
+// file contents (else 0), or -1 on error. Only make parent directories or
+// remove an old file after the first attempt fails, to save syscalls.
+static int make_entry(char *name, int ala)
+{
+  int fd, try = 0, excl = !FLAG(k) || !FLAG(overwrite);
+  char *err = (S_ISLNK(ala) || TT.hdr.link_target)
+    ? "can't link '%s' -> '%s'" : S_ISREG(ala) ? "%s"
+    : S_ISDIR(ala) ? "%s: can't create" : "can't create '%s'";
+
+  for (;;) {
+    if (!S_ISREG(ala)) {
+      if (S_ISDIR(ala)) {
+        if ((fd = mkdir(name, 0700)) && errno==EEXIST) return 0;
+      } else if (S_ISLNK(ala)) fd = symlink(TT.hdr.link_target, name);
+      else fd = mknod(name, ala, TT.hdr.device);
+    } else if (TT.hdr.link_target) fd = link(TT.hdr.link_target, name);
+    else fd = open(name, O_WRONLY|O_CREAT|(excl ? O_EXCL : O_TRUNC),
+                   ala & 07777);
+    if (fd != -1 || try++>2) break;
+
+    // create path before file if necessary, remove old file if it exists
+    if (errno==ENOENT && strrchr(name, '/')) {
+      if (mkpath(name) && errno!=EEXIST) {
+        err = ":%s: can't mkdir";
+        break;
+      }
+    } else if (errno!=EEXIST || FLAG(k) || S_ISDIR(ala)) break;
+    else if (unlink(name)) {
+      err = "can't remove: %s";
+      break;
+    }
+  }
+  if (fd == -1) perror_msg(err, name, TT.hdr.link_target);
+
+  return fd;
 }
 
 static void extract_to_disk(void)
 {
   char *name = TT.hdr.name;
-  int ala = TT.hdr.mode;
+  int ala = TT.hdr.mode, fd;
 
   if (dirflush(name)) {
     if (S_ISREG(ala) && !TT.hdr.link_target) skippy(TT.hdr.size);
@@ -475,56 +521,28 @@ static void extract_to_disk(void)
     return;
   }
 
-  // create path before file if necessary
-  if (strrchr(name, '/') && mkpath(name) && errno !=EEXIST)
-      return perror_msg(":%s: can't mkdir", name);
+  if (-1 == (fd = make_entry(name, ala))) {
+    if (S_ISREG(ala) && !TT.hdr.link_target) skippy(TT.hdr.size);
 
-  // remove old file, if exists
-  if (!FLAG(k) && !S_ISDIR(ala) && unlink(name) && errno!=ENOENT)
-    return perror_msg("can't remove: %s", name);
+    return;
+  }
+  if (fd) sendfile_sparse(fd);
 
-  if (S_ISREG(ala)) {
-    // hardlink?
-    if (TT.hdr.link_target) {
-      if (link(TT.hdr.link_target, name))
-        return perror_msg("can't link '%s' -> '%s'", name, TT.hdr.link_target);
-    // write contents
-    } else {
-      int fd = xcreate(name, O_WRONLY|O_CREAT|(FLAG(overwrite)?O_TRUNC:O_EXCL),
-        WARN_ONLY|(ala & 07777));
-      if (fd != -1) sendfile_sparse(fd);
-      else skippy(TT.hdr.size);
-    }
-  } else if (S_ISDIR(ala)) {
-    if ((mkdir(name, 0700) == -1) && errno != EEXIST)
-      return perror_msg("%s: can't create", TT.hdr.name);
-  } else if (S_ISLNK(ala)) {
-    if (symlink(TT.hdr.link_target, TT.hdr.name))
-      return perror_msg("can't link '%s' -> '%s'", name, TT.hdr.link_target);
-  } else if (mknod(name, ala, TT.hdr.device))
-    return perror_msg("can't create '%s'", name);
-
-  // Set ownership
+  // Set ownership, using the file descriptor when we have one
   if (!FLAG(o) && !geteuid()) {
     int u = TT.hdr.uid, g = TT.hdr.gid;
 
-    if (TT.owner) TT.hdr.uid = TT.ouid;
-    else if (!FLAG(numeric_owner) && *TT.hdr.uname) {
-      struct passwd *pw = getpwnam(TT.hdr.uname);
-      if (pw && (TT.owner || !FLAG(numeric_owner))) TT.hdr.uid = pw->pw_uid;
-    }
+    if (fd ? fchown(fd, u, g) : lchown(name, u, g))
+      perror_msg("chown %d:%d '%s'", u, g, name);
+  }
 
-    if (TT.group) TT.hdr.gid = TT.ggid;
-    else if (!FLAG(numeric_owner) && *TT.hdr.uname) {
-      struct group *gr = getgrnam(TT.hdr.gname);
-      if (gr) TT.hdr.gid = gr->gr_gid;
-    }
+  if (!S_ISLNK(ala)) {
+    mode_t mode = ala & (FLAG(p) ? 07777 : 0777);
 
-    if (lchown(name, u, g)) perror_msg("chown %d:%d '%s'", u, g, name);;
+    if (fd) fchmod(fd, mode);
+    else chmod(name, mode);
   }
 
-  if (!S_ISLNK(ala)) chmod(TT.hdr.name, FLAG(p) ? ala : ala&0777);
-
   // Apply mtime.
   if (!FLAG(m)) {
     if (S_ISDIR(ala)) {
@@ -538,8 +556,31 @@ static void extract_to_disk(void)
       strcpy(sl->str+sizeof(long long), name);
       sl->next = TT.dirs;
       TT.dirs = sl;
-    } else wsettime(TT.hdr.name, TT.hdr.mtime);
+    } else if (fd) {
+      struct timespec times[2] = {{TT.hdr.mtime, 0},{TT.hdr.mtime, 0}};
+
+      if (futimens(fd, times)) perror_msg("settime %lld %s",
+        (long long)TT.hdr.mtime, name);
+    } else wsettime(name, TT.hdr.mtime);
+  }
+  if (fd) close(fd);
+}
+
+// Map archive user (or group) name to local id, or -1 if none. Caches the
+// last lookup because archives tend to repeat the same few names.
+static int name2id(char *name, int grp)
+{
+  struct passwd *pw;
+  struct group *gr;
+
+  if (!TT.idname[grp] || strcmp(name, TT.idname[grp])) {
+    free(TT.idname[grp]);
+    TT.idname[grp] = xstrdup(name);
+    if (grp) TT.id[grp] = (gr = getgrnam(name)) ? gr->gr_gid : -1;
+    else TT.id[grp] = (pw = getpwnam(name)) ? pw->pw_uid : -1;
   }
+
+  return TT.id[grp];
 }
 
 static void unpack_tar(char *first)
@@ -654,16 +695,12 @@ static void unpack_tar(char *first)
     TT.hdr.gname = xstrndup(TT.group ? TT.group : tar.gname, sizeof(tar.gname));
 
     if (TT.owner) TT.hdr.uid = TT.ouid;
-    else if (!FLAG(numeric_owner)) {
-      struct passwd *pw = getpwnam(TT.hdr.uname);
-      if (pw && (TT.owner || !FLAG(numeric_owner))) TT.hdr.uid = pw->pw_uid;
-    }
+    else if (!FLAG(numeric_owner) && -1 != (i = name2id(TT.hdr.uname, 0)))
+      TT.hdr.uid = i;
 
     if (TT.group) TT.hdr.gid = TT.ggid;
-    else if (!FLAG(numeric_owner)) {
-      struct group *gr = getgrnam(TT.hdr.gname);
-      if (gr) TT.hdr.gid = gr->gr_gid;
-    }
+    else if (!FLAG(numeric_owner) && -1 != (i = name2id(TT.hdr.gname, 1)))
+      TT.hdr.gid = i;
 
     if (!TT.hdr.link_target && *tar.link)
       TT.hdr.link_target = xstrndup(tar.link, sizeof(tar.link));
@@ -745,6 +782,7 @@ static void unpack_tar(char *first)
           pid = xpopen((char *[]){"sh", "-c", TT.to_command, NULL}, &fd, 0);
           // todo: short write exits tar here, other skips data.
           sendfile_sparse(fd);
+          close(fd);
           fd = xpclose_both(pid, 0);
           if (fd) error_msg("%d: Child returned %d", pid, fd);
         }
@@ -835,11 +873,9 @@ void tar_main(void)
     if (!(FLAG(j)||FLAG(z)||FLAG(J))) {
       len = xread(TT.fd, hdr = toybuf+sizeof(toybuf)-512, 512);
       if (len!=512 || !is_tar_header(hdr)) {
-        // detect gzip and bzip signatures
-        if (SWAP_BE16(*(short *)hdr)==0x1f8b) toys.optflags |= FLAG_z;
-        else if (!memcmp(hdr, "BZh", 3)) toys.optflags |= FLAG_j;
-        else if (peek_be(hdr, 7) == 0xfd377a585a0000) toys.optflags |= FLAG_J;
-        else error_exit("Not tar");
+        // detect gzip, bzip, and xz signatures
+        if (!(s = compression_cat(hdr, len))) error_exit("Not tar");
+        toys.optflags |= (*s=='z') ? FLAG_z : (*s=='b') ? FLAG_j : FLAG_J;
 
         // if we can seek back we don't need to loop and copy data
         if (!lseek(TT.fd, -len, SEEK_CUR)) hdr = 0;
@@ -848,13 +884,10 @@ void tar_main(void)
 
     if (FLAG(j)||FLAG(z)||FLAG(J)) {
       int pipefd[2] = {hdr ? -1 : TT.fd, -1}, i, pid;
-      struct string_list *zcat = find_in_path(getenv("PATH"),
-        FLAG(j) ? "bzcat" : FLAG(J) ? "xz" : "zcat");
 
-      // Toybox provides more decompressors than compressors, so try them first
-      xpopen_both(zcat ? (char *[]){zcat->str, 0} :
-        (char *[]){archiver, "-dc", 0}, pipefd);
-      if (CFG_TOYBOX_FREE) llist_traverse(zcat, free);
+      // Toybox provides more decompressors than compressors, so try them
+      // first. Builtin ones decode in our forked child without an exec.
+      xpopen_cat(FLAG(j) ? "bzcat" : FLAG(J) ? "xzcat" : "zcat", pipefd);
 
       if (!hdr) {
         // If we could seek, child gzip inherited fd and we read its output
@@ -24,17 +24,28 @@ GLOBALS(
   char *o;
 )
 
+// Get next line without trailing newline
+static char *uu_line(FILE *fp, char **line, size_t *size)
+{
+  ssize_t len = getline(line, size, fp);
+
+  if (len<1) return 0;
+  if ((*line)[len-1] == '\n') (*line)[len-1] = 0;
+
+  return *line;
+}
+
 void uudecode_main(void)
 {
-  int ifd = 0, ofd, idx = 0, m = m;
+  FILE *fp = toys.optc ? xfdopen(xopenro(*toys.optargs), "r") : stdin;
+  int ofd, idx = 0, m = m, olen, len, used = 0;
+  unsigned state;
+  size_t size = 0;
   char *line = 0, mode[16],
        *class[] = {"begin%*[ ]%15s%*[ ]%n", "begin-base64%*[ ]%15s%*[ ]%n"};
 
-  if (toys.optc) ifd = xopenro(*toys.optargs);
-
   while (!idx) {
-    free(line);
-    if (!(line = get_line(ifd))) error_exit("bad EOF");
+    if (!uu_line(fp, &line, &size)) error_exit("bad EOF");
     for (m=0; m < 2; m++) {
       sscanf(line, class[m], mode, &idx);
       if (idx) break;
@@ -45,64 +56,47 @@ void uudecode_main(void)
   else ofd = xcreate(TT.o ? TT.o : line+idx, O_WRONLY|O_CREAT|O_TRUNC,
     string_to_mode(mode, 0777^toys.old_umask));
 
-  for(;;) {
-    char *in, *out;
-    int olen;
+  // Decode each line in place, collecting output in toybuf.
+  while (uu_line(fp, &line, &size)) {
+    char *in = line, *out = line;
 
-    free(line);
-    if (m == 2 || !(line = get_line(ifd))) break;
-    if (!strcmp(line, m ? "====" : "end")) {
-      m = 2;
-      continue;
-    }
+    if (!strcmp(line, m ? "====" : "end")) break;
 
-    olen = 0;
-    in = out = line;
-    if (!m) olen = (*(in++) - 32) & 0x3f;
+    if (m) {
+      state = 0;
+      len = strlen(line);
+      out += base64_decode(line, line, &len, &state, 1);
+    } else for (olen = (*(in++) - 32) & 0x3f; olen > 0; ) {
+      int i = 0, x = 0;
 
-    for (;;) {
-      int i = 0, x = 0, len = 4;
-      char c = 0;
-
-      if (!m) {
-        if (olen < 1) break;
-        if (olen < 3) len = olen + 1;
-      }
-
-      while (i < len) {
-        if (!(c = *(in++))) goto line_done;
-
-        if (m) {
-          if (c == '=') {
-            len--;
-            continue;
-          } else if (len != 4) break;
-
-          if (c >= 'A' && c <= 'Z') c -= 'A';
-          else if (c >= 'a' && c <= 'z') c += 26 - 'a';
-          else if (c >= '0' && c <= '9') c += 52 - '0';
-          else if (c == '+') c = 62;
-          else if (c == '/') c = 63;
-          else continue;
-        } else c = (c - 32) & 0x3f;
-
-        x |= c << (6*(3-i));
-
-        if (i && i < len) {
+      for (len = (olen < 3) ? olen+1 : 4; i < len; i++) {
+        if (!*in) {
+          if (i) error_exit("bad %s", line);
+          goto line_done;
+        }
+        x |= ((*(in++) - 32) & 0x3f) << (6*(3-i));
+        if (i) {
           *(out++) = (x>>(8*(3-i))) & 0xff;
           olen--;
         }
-        i++;
       }
-
-      if (i && i!=len) error_exit("bad %s", line);
     }
 line_done:
-    xwrite(ofd, line, out-line);
+    if (used+(out-line) > sizeof(toybuf)) {
+      xwrite(ofd, toybuf, used);
+      used = 0;
+    }
+    if (out-line > sizeof(toybuf)) xwrite(ofd, line, out-line);
+    else {
+      memcpy(toybuf+used, line, out-line);
+      used += out-line;
+    }
   }
+  xwrite(ofd, toybuf, used);
 
   if (CFG_TOYBOX_FREE) {
-    if (ifd) close(ifd);
+    free(line);
+    if (fp != stdin) fclose(fp);
     close(ofd);
   }
 }
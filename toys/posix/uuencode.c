@@ -22,37 +22,34 @@ config UUENCODE
 
 void uuencode_main(void)
 {
-  char *name = toys.optargs[toys.optc-1], buf[(76/4)*3];
-
-  int i, m = FLAG(m), fd = 0;
+  char *name = toys.optargs[toys.optc-1], *o;
+  unsigned char *in = (void *)libbuf;
+  int i, j, k, n, len, m = FLAG(m), fd = 0, line = m ? 57 : 45;
+  unsigned x;
 
   if (toys.optc > 1) fd = xopenro(toys.optargs[0]);
 
-  base64_init(toybuf);
-
   xprintf("begin%s 744 %s\n", m ? "-base64" : "", name);
-  for (;;) {
-    char *in;
-
-    if (!(i = xread(fd, buf, m ? sizeof(buf) : 45))) break;
-
-    if (!m) xputc(i+32);
-    in = buf;
 
-    for (in = buf; in-buf < i; ) {
-      int j, x, bytes = i - (in-buf);
-
-      if (bytes > 3) bytes = 3;
-
-      for (j = x = 0; j<4; j++) {
-        int out;
-
-        if (j < bytes) x |= (*(in++) & 0x0ff) << (8*(2-j));
-        out = (x>>((3-j)*6)) & 0x3f;
-        xputc(m ? (j > bytes ? '=' : toybuf[out]) : (out ? out + 0x20 : 0x60));
-      } 
+  // Read 45 lines at a time (a multiple of both line sizes that fits in
+  // libbuf), and write out everything that encodes to in one go.
+  for (;;) {
+    if (0>(len = readall(fd, in, 57*45))) perror_exit(0);
+    for (o = toybuf, i = 0; i<len; i += n) {
+      n = minof(line, len-i);
+      if (m) o += base64_encode(o, (void *)in+i, n);
+      else {
+        *o++ = n+32;
+        for (j = 0; j<n; j += 3) {
+          x = (in[i+j]<<16) | ((j+1<n) ? in[i+j+1]<<8 : 0)
+            | ((j+2<n) ? in[i+j+2] : 0);
+          for (k = 18; k>=0; k -= 6) *o++ = ((x>>k)&63) ? ((x>>k)&63)+32 : 96;
+        }
+      }
+      *o++ = '\n';
     }
-    xputc('\n');
+    xwrite(1, toybuf, o-toybuf);
+    if (len < 57*45) break;
   }
   xputs(m ? "====" : "end");
 }
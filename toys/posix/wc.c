@@ -29,6 +29,7 @@ config WC
 
 GLOBALS(
   unsigned long totals[4];
+  char space[256];
 )
 
 static void show_lengths(unsigned long *lengths, char *name)
@@ -79,23 +80,49 @@ static void do_wc(int fd, char *name)
     else len += len2;
     if (len2<1) done++;
 
-    for (pos = 0; pos<len; pos++) {
+    // Speed up common case: wc -l only counts newlines, which memchr() finds
+    // faster than a byte at a time loop.
+    if (toys.optflags == FLAG_l) {
+      char *s = toybuf, *end = toybuf+len;
+
+      while ((s = memchr(s, '\n', end-s))) s++, lengths[0]++;
+      pos = len;
+
+    // Without -m, test space with a lookup table and count words at the
+    // transitions from space to nonspace.
+    } else if (!FLAG(m)) {
+      unsigned long lines = 0, words = 0;
+
+      for (pos = 0; pos<len; pos++) {
+        lines += toybuf[pos]=='\n';
+        space = TT.space[toybuf[pos]];
+        words += !word && !space;
+        word = !space;
+      }
+      lengths[0] += lines;
+      lengths[1] += words;
+      lengths[2] += len;
+    } else for (pos = 0; pos<len; pos++) {
       if (toybuf[pos]=='\n') lengths[0]++;
       lengths[2]++;
-      if (FLAG(m)) {
-        // If we've consumed next wide char
-        if (--clen<1) {
-          wchar_t wchar;
 
+      // If we've consumed next wide char
+      if (--clen<1) {
+        wchar_t wchar;
+
+        // ASCII is always one character, only decode the rest
+        if (toybuf[pos]<128) {
+          clen = 1;
+          space = TT.space[toybuf[pos]];
+        } else {
           // next wide size, don't count invalid, fetch more data if necessary
           clen = utf8towc(&wchar, toybuf+pos, len-pos);
           if (clen == -1) continue;
           if (clen == -2 && !done) break;
-
-          lengths[3]++;
           space = iswspace(wchar);
         }
-      } else space = isspace(toybuf[pos]);
+        lengths[3]++;
+      }
 
       if (space) word=0;
       else {
@@ -114,6 +141,9 @@ show:
 
 void wc_main(void)
 {
+  int i;
+
+  for (i = 0; i<256; i++) TT.space[i] = !!isspace(i);
   if (!toys.optflags) toys.optflags = FLAG_l|FLAG_w|FLAG_c;
   loopfiles(toys.optargs, do_wc);
   if (toys.optc>1) show_lengths(TT.totals, "total");